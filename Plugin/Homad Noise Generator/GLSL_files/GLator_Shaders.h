@@ -0,0 +1,732 @@
+/*
+	GLator_Shaders.h
+
+	Generated by Util/EmbedShaders.py from the files in GLSL_files, do not edit.
+*/
+
+#pragma once
+
+#ifndef GLATOR_SHADERS_H
+#define GLATOR_SHADERS_H
+
+namespace AESDK_OpenGL
+{
+
+constexpr char kShader_vertex_shader_vert[] =
+R"GLSL(#version 330
+in vec4 Position;
+in vec2 UVs;
+out vec4 out_pos;
+out vec2 out_uvs;
+// - per render values, in a uniform buffer of the render context: the program is shared by all contexts
+// - mirrors RenderBlock (GLator.cpp)
+layout(std140) uniform RenderParams
+{
+	mat4 ModelviewProjection;
+	// position of the rendered tile in the layer, in pixels
+	vec2 tileOffset;
+	float multiplier16bit;
+};
+
+void main( void )
+{
+    out_pos = ModelviewProjection * Position;
+    gl_Position = out_pos;
+	out_uvs = UVs;
+})GLSL"
+;
+
+constexpr char kShader_fragment_shader_frag[] =
+R"GLSL(#version 330
+uniform sampler2D videoTexture;
+// - per render values, in a uniform buffer of the render context: the program is shared by all contexts
+// - mirrors RenderBlock (GLator.cpp)
+layout(std140) uniform RenderParams
+{
+	mat4 ModelviewProjection;
+	// position of the rendered tile in the layer, in pixels
+	vec2 tileOffset;
+	float multiplier16bit;
+};
+// - mirrors NoiseStackParams::layers (GLator.h), uploaded to a uniform buffer
+// - two vec4 per layer: (VALUE_1..VALUE_4) and (POS_MULT, MIX, extra, extra)
+layout(std140) uniform NoiseParams
+{
+	vec4 noiseLayers[30];
+};
+in vec4 out_pos;
+in vec2 out_uvs;
+out vec4 colourOut;
+
+// - layer slots, in the order of the THOR_*_CB toggles (see GLator.h)
+// - the host compiles one program per set of enabled layers and defines
+//   THOR_<layer>_ON for each of them, so switched off layers cost nothing
+#define NOISE_LAYER_GENERIC_1D		0
+#define NOISE_LAYER_GENERIC_2D		1
+#define NOISE_LAYER_GENERIC_3D		2
+#define NOISE_LAYER_PERLIN_2D		3
+#define NOISE_LAYER_PERLIN_3D		4
+#define NOISE_LAYER_PERLIN_4D		5
+#define NOISE_LAYER_SIMPLEX_2D		6
+#define NOISE_LAYER_SIMPLEX_3D		7
+#define NOISE_LAYER_SIMPLEX_4D		8
+#define NOISE_LAYER_VIQ_2D			9
+#define NOISE_LAYER_VORONOI_2D		10
+#define NOISE_LAYER_FRACTBROWN_1D	11
+#define NOISE_LAYER_FRACTBROWN_2D	12
+#define NOISE_LAYER_FRACTBROWN_3D	13
+#define NOISE_LAYER_FRACTBROWN_IQ	14
+
+// pixels -> noise space for POS_MULT == 1, and VALUE -> noise space offset
+#define THOR_PIXEL_SCALE	0.01
+#define THOR_VALUE_SCALE	10.0
+#define THOR_FBM_OCTAVES	5
+
+/*
+** Hashing - integer only, so the CPU port produces the exact same lattice values
+*/
+uint thorHash(uint x)
+{
+	x ^= x >> 16u;
+	x *= 0x7feb352du;
+	x ^= x >> 15u;
+	x *= 0x846ca68bu;
+	x ^= x >> 16u;
+	return x;
+}
+
+float thorHashToFloat(uint h)
+{
+	return float(h >> 8u) * (1.0 / 16777216.0);
+}
+
+uint thorHash2(ivec2 p)
+{
+	return thorHash(uint(p.x) + thorHash(uint(p.y)));
+}
+
+uint thorHash3(ivec3 p)
+{
+	return thorHash(uint(p.x) + thorHash(uint(p.y) + thorHash(uint(p.z))));
+}
+
+float hash11(int p)		{ return thorHashToFloat(thorHash(uint(p))); }
+float hash21(ivec2 p)	{ return thorHashToFloat(thorHash2(p)); }
+float hash31(ivec3 p)	{ return thorHashToFloat(thorHash3(p)); }
+
+vec2 hash22(ivec2 p)
+{
+	uint h = thorHash2(p);
+	return vec2(thorHashToFloat(h), thorHashToFloat(thorHash(h)));
+}
+
+vec3 hash23(ivec2 p)
+{
+	uint h0 = thorHash2(p);
+	uint h1 = thorHash(h0);
+	return vec3(thorHashToFloat(h0), thorHashToFloat(h1), thorHashToFloat(thorHash(h1)));
+}
+
+/*
+** Generic (value) noise
+*/
+float genericNoise(float p)
+{
+	float i = floor(p);
+	float f = p - i;
+	f = f * f * (3.0 - 2.0 * f);
+	return mix(hash11(int(i)), hash11(int(i) + 1), f);
+}
+
+float genericNoise(vec2 p)
+{
+	vec2 pi = floor(p);
+	ivec2 i = ivec2(pi);
+	vec2 f = p - pi;
+	f = f * f * (3.0 - 2.0 * f);
+	return mix(mix(hash21(i), hash21(i + ivec2(1, 0)), f.x),
+			   mix(hash21(i + ivec2(0, 1)), hash21(i + ivec2(1, 1)), f.x), f.y);
+}
+
+float genericNoise(vec3 p)
+{
+	vec3 pi = floor(p);
+	ivec3 i = ivec3(pi);
+	vec3 f = p - pi;
+	f = f * f * (3.0 - 2.0 * f);
+	float z0 = mix(mix(hash31(i), hash31(i + ivec3(1, 0, 0)), f.x),
+				   mix(hash31(i + ivec3(0, 1, 0)), hash31(i + ivec3(1, 1, 0)), f.x), f.y);
+	float z1 = mix(mix(hash31(i + ivec3(0, 0, 1)), hash31(i + ivec3(1, 0, 1)), f.x),
+				   mix(hash31(i + ivec3(0, 1, 1)), hash31(i + ivec3(1, 1, 1)), f.x), f.y);
+	return mix(z0, z1, f.z);
+}
+
+/*
+** Gradient noise helpers (after Stefan Gustavson / Ashima Arts, MIT license)
+*/
+float mod289(float x)	{ return x - floor(x * (1.0 / 289.0)) * 289.0; }
+vec2 mod289(vec2 x)		{ return x - floor(x * (1.0 / 289.0)) * 289.0; }
+vec3 mod289(vec3 x)		{ return x - floor(x * (1.0 / 289.0)) * 289.0; }
+vec4 mod289(vec4 x)		{ return x - floor(x * (1.0 / 289.0)) * 289.0; }
+
+float permute(float x)	{ return mod289(((x * 34.0) + 1.0) * x); }
+vec3 permute(vec3 x)	{ return mod289(((x * 34.0) + 1.0) * x); }
+vec4 permute(vec4 x)	{ return mod289(((x * 34.0) + 1.0) * x); }
+
+float taylorInvSqrt(float r)	{ return 1.79284291400159 - 0.85373472095314 * r; }
+vec4 taylorInvSqrt(vec4 r)		{ return 1.79284291400159 - 0.85373472095314 * r; }
+
+vec2 fade(vec2 t) { return t * t * t * (t * (t * 6.0 - 15.0) + 10.0); }
+vec3 fade(vec3 t) { return t * t * t * (t * (t * 6.0 - 15.0) + 10.0); }
+vec4 fade(vec4 t) { return t * t * t * (t * (t * 6.0 - 15.0) + 10.0); }
+
+/*
+** Classic Perlin noise, range [-1, 1]
+*/
+float perlinNoise(vec2 P)
+{
+	vec4 Pi = mod289(floor(P.xyxy) + vec4(0.0, 0.0, 1.0, 1.0));
+	vec4 Pf = fract(P.xyxy) - vec4(0.0, 0.0, 1.0, 1.0);
+	vec4 ix = Pi.xzxz;
+	vec4 iy = Pi.yyww;
+	vec4 fx = Pf.xzxz;
+	vec4 fy = Pf.yyww;
+
+	vec4 i = permute(permute(ix) + iy);
+
+	vec4 gx = fract(i * (1.0 / 41.0)) * 2.0 - 1.0;
+	vec4 gy = abs(gx) - 0.5;
+	gx = gx - floor(gx + 0.5);
+
+	vec4 norm = taylorInvSqrt(gx * gx + gy * gy);
+	gx *= norm;
+	gy *= norm;
+
+	vec4 n = gx * fx + gy * fy;
+
+	vec2 fade_xy = fade(Pf.xy);
+	vec2 n_x = mix(n.xz, n.yw, fade_xy.x);
+	return 2.3 * mix(n_x.x, n_x.y, fade_xy.y);
+}
+
+// gradients for four lattice corners, packed per component
+void perlinGrad3(vec4 ixy, out vec4 gx, out vec4 gy, out vec4 gz)
+{
+	gx = ixy * (1.0 / 7.0);
+	gy = fract(floor(gx) * (1.0 / 7.0)) - 0.5;
+	gx = fract(gx);
+	gz = vec4(0.5) - abs(gx) - abs(gy);
+	vec4 sz = step(gz, vec4(0.0));
+	gx -= sz * (step(0.0, gx) - 0.5);
+	gy -= sz * (step(0.0, gy) - 0.5);
+
+	vec4 norm = taylorInvSqrt(gx * gx + gy * gy + gz * gz);
+	gx *= norm;
+	gy *= norm;
+	gz *= norm;
+}
+
+float perlinNoise(vec3 P)
+{
+	vec3 Pi0 = mod289(floor(P));
+	vec3 Pi1 = mod289(floor(P) + vec3(1.0));
+	vec3 Pf0 = fract(P);
+	vec3 Pf1 = Pf0 - vec3(1.0);
+	vec4 ix = vec4(Pi0.x, Pi1.x, Pi0.x, Pi1.x);
+	vec4 iy = vec4(Pi0.yy, Pi1.yy);
+	vec4 fx = vec4(Pf0.x, Pf1.x, Pf0.x, Pf1.x);
+	vec4 fy = vec4(Pf0.yy, Pf1.yy);
+
+	vec4 ixy = permute(permute(ix) + iy);
+	vec4 gx0, gy0, gz0, gx1, gy1, gz1;
+	perlinGrad3(permute(ixy + Pi0.zzzz), gx0, gy0, gz0);
+	perlinGrad3(permute(ixy + Pi1.zzzz), gx1, gy1, gz1);
+
+	vec4 n_z0 = gx0 * fx + gy0 * fy + gz0 * Pf0.z;
+	vec4 n_z1 = gx1 * fx + gy1 * fy + gz1 * Pf1.z;
+
+	vec3 fade_xyz = fade(Pf0);
+	vec4 n_z = mix(n_z0, n_z1, fade_xyz.z);
+	vec2 n_yz = mix(n_z.xy, n_z.zw, fade_xyz.y);
+	return 2.2 * mix(n_yz.x, n_yz.y, fade_xyz.x);
+}
+
+void perlinGrad4(vec4 ixy, out vec4 gx, out vec4 gy, out vec4 gz, out vec4 gw)
+{
+	gx = ixy * (1.0 / 7.0);
+	gy = floor(gx) * (1.0 / 7.0);
+	gz = floor(gy) * (1.0 / 6.0);
+	gx = fract(gx) - 0.5;
+	gy = fract(gy) - 0.5;
+	gz = fract(gz) - 0.5;
+	gw = vec4(0.75) - abs(gx) - abs(gy) - abs(gz);
+	vec4 sw = step(gw, vec4(0.0));
+	gx -= sw * (step(0.0, gx) - 0.5);
+	gy -= sw * (step(0.0, gy) - 0.5);
+
+	vec4 norm = taylorInvSqrt(gx * gx + gy * gy + gz * gz + gw * gw);
+	gx *= norm;
+	gy *= norm;
+	gz *= norm;
+	gw *= norm;
+}
+
+float perlinNoise(vec4 P)
+{
+	vec4 Pi0 = mod289(floor(P));
+	vec4 Pi1 = mod289(floor(P) + 1.0);
+	vec4 Pf0 = fract(P);
+	vec4 Pf1 = Pf0 - 1.0;
+	vec4 ix = vec4(Pi0.x, Pi1.x, Pi0.x, Pi1.x);
+	vec4 iy = vec4(Pi0.yy, Pi1.yy);
+	vec4 fx = vec4(Pf0.x, Pf1.x, Pf0.x, Pf1.x);
+	vec4 fy = vec4(Pf0.yy, Pf1.yy);
+
+	vec4 ixy = permute(permute(ix) + iy);
+	vec4 ixy0 = permute(ixy + Pi0.zzzz);
+	vec4 ixy1 = permute(ixy + Pi1.zzzz);
+
+	vec4 gx, gy, gz, gw;
+	perlinGrad4(permute(ixy0 + Pi0.wwww), gx, gy, gz, gw);
+	vec4 n_00 = gx * fx + gy * fy + gz * Pf0.z + gw * Pf0.w;
+	perlinGrad4(permute(ixy1 + Pi0.wwww), gx, gy, gz, gw);
+	vec4 n_10 = gx * fx + gy * fy + gz * Pf1.z + gw * Pf0.w;
+	perlinGrad4(permute(ixy0 + Pi1.wwww), gx, gy, gz, gw);
+	vec4 n_01 = gx * fx + gy * fy + gz * Pf0.z + gw * Pf1.w;
+	perlinGrad4(permute(ixy1 + Pi1.wwww), gx, gy, gz, gw);
+	vec4 n_11 = gx * fx + gy * fy + gz * Pf1.z + gw * Pf1.w;
+
+	vec4 fade_xyzw = fade(Pf0);
+	vec4 n_0w = mix(n_00, n_01, fade_xyzw.w);
+	vec4 n_1w = mix(n_10, n_11, fade_xyzw.w);
+	vec4 n_zw = mix(n_0w, n_1w, fade_xyzw.z);
+	vec2 n_yzw = mix(n_zw.xy, n_zw.zw, fade_xyzw.y);
+	return 2.2 * mix(n_yzw.x, n_yzw.y, fade_xyzw.x);
+}
+
+/*
+** Simplex noise, range [-1, 1]
+*/
+float simplexNoise(vec2 v)
+{
+	const vec4 C = vec4(0.211324865405187,	// (3.0-sqrt(3.0))/6.0
+						0.366025403784439,	// 0.5*(sqrt(3.0)-1.0)
+						-0.577350269189626,	// -1.0 + 2.0 * C.x
+						0.024390243902439);	// 1.0 / 41.0
+	vec2 i = floor(v + dot(v, C.yy));
+	vec2 x0 = v - i + dot(i, C.xx);
+)GLSL"
+R"GLSL(	vec2 i1 = (x0.x > x0.y) ? vec2(1.0, 0.0) : vec2(0.0, 1.0);
+	vec4 x12 = x0.xyxy + C.xxzz;
+	x12.xy -= i1;
+
+	i = mod289(i);
+	vec3 p = permute(permute(i.y + vec3(0.0, i1.y, 1.0)) + i.x + vec3(0.0, i1.x, 1.0));
+
+	vec3 m = max(0.5 - vec3(dot(x0, x0), dot(x12.xy, x12.xy), dot(x12.zw, x12.zw)), 0.0);
+	m = m * m;
+	m = m * m;
+
+	vec3 x = 2.0 * fract(p * C.www) - 1.0;
+	vec3 h = abs(x) - 0.5;
+	vec3 a0 = x - floor(x + 0.5);
+	m *= 1.79284291400159 - 0.85373472095314 * (a0 * a0 + h * h);
+
+	vec3 g = vec3(a0.x * x0.x + h.x * x0.y, a0.yz * x12.xz + h.yz * x12.yw);
+	return 130.0 * dot(m, g);
+}
+
+float simplexNoise(vec3 v)
+{
+	const vec2 C = vec2(1.0 / 6.0, 1.0 / 3.0);
+
+	vec3 i = floor(v + dot(v, C.yyy));
+	vec3 x0 = v - i + dot(i, C.xxx);
+
+	vec3 g = step(x0.yzx, x0.xyz);
+	vec3 l = 1.0 - g;
+	vec3 i1 = min(g.xyz, l.zxy);
+	vec3 i2 = max(g.xyz, l.zxy);
+
+	vec3 x1 = x0 - i1 + C.xxx;
+	vec3 x2 = x0 - i2 + C.yyy;
+	vec3 x3 = x0 - 0.5;
+
+	i = mod289(i);
+	vec4 p = permute(permute(permute(
+				i.z + vec4(0.0, i1.z, i2.z, 1.0))
+			+ i.y + vec4(0.0, i1.y, i2.y, 1.0))
+			+ i.x + vec4(0.0, i1.x, i2.x, 1.0));
+
+	// gradients: 7x7 points over a square, mapped onto an octahedron
+	vec4 j = p - 49.0 * floor(p * (1.0 / 49.0));
+	vec4 x_ = floor(j * (1.0 / 7.0));
+	vec4 y_ = floor(j - 7.0 * x_);
+	vec4 gx = x_ * (2.0 / 7.0) + (0.5 / 7.0 - 1.0);
+	vec4 gy = y_ * (2.0 / 7.0) + (0.5 / 7.0 - 1.0);
+	vec4 gz = 1.0 - abs(gx) - abs(gy);
+	vec4 sh = -step(gz, vec4(0.0));
+	gx += (floor(gx) * 2.0 + 1.0) * sh;
+	gy += (floor(gy) * 2.0 + 1.0) * sh;
+
+	vec4 norm = taylorInvSqrt(gx * gx + gy * gy + gz * gz);
+	gx *= norm;
+	gy *= norm;
+	gz *= norm;
+
+	vec4 dx = vec4(x0.x, x1.x, x2.x, x3.x);
+	vec4 dy = vec4(x0.y, x1.y, x2.y, x3.y);
+	vec4 dz = vec4(x0.z, x1.z, x2.z, x3.z);
+
+	vec4 m = max(0.5 - (dx * dx + dy * dy + dz * dz), 0.0);
+	m = m * m;
+	return 105.0 * dot(m * m, gx * dx + gy * dy + gz * dz);
+}
+
+vec4 simplexGrad4(float j, vec4 ip)
+{
+	vec4 p;
+	p.xyz = floor(fract(vec3(j) * ip.xyz) * 7.0) * ip.z - 1.0;
+	p.w = 1.5 - dot(abs(p.xyz), vec3(1.0));
+	vec4 s = vec4(lessThan(p, vec4(0.0)));
+	p.xyz = p.xyz + (s.xyz * 2.0 - 1.0) * s.www;
+	return p;
+}
+
+float simplexNoise(vec4 v)
+{
+	const vec4 C = vec4(0.138196601125011,	// (5 - sqrt(5))/20  G4
+						0.276393202250021,	// 2 * G4
+						0.414589803375032,	// 3 * G4
+						-0.447213595499958);	// -1 + 4 * G4
+	const float F4 = 0.309016994374947451;
+
+	vec4 i = floor(v + dot(v, vec4(F4)));
+	vec4 x0 = v - i + dot(i, C.xxxx);
+
+	vec4 i0;
+	vec3 isX = step(x0.yzw, x0.xxx);
+	vec3 isYZ = step(x0.zww, x0.yyz);
+	i0.x = isX.x + isX.y + isX.z;
+	i0.yzw = 1.0 - isX;
+	i0.y += isYZ.x + isYZ.y;
+	i0.zw += 1.0 - isYZ.xy;
+	i0.z += isYZ.z;
+	i0.w += 1.0 - isYZ.z;
+
+	vec4 i3 = clamp(i0, 0.0, 1.0);
+	vec4 i2 = clamp(i0 - 1.0, 0.0, 1.0);
+	vec4 i1 = clamp(i0 - 2.0, 0.0, 1.0);
+
+	vec4 x1 = x0 - i1 + C.xxxx;
+	vec4 x2 = x0 - i2 + C.yyyy;
+	vec4 x3 = x0 - i3 + C.zzzz;
+	vec4 x4 = x0 + C.wwww;
+
+	i = mod289(i);
+	float j0 = permute(permute(permute(permute(i.w) + i.z) + i.y) + i.x);
+	vec4 j1 = permute(permute(permute(permute(
+				i.w + vec4(i1.w, i2.w, i3.w, 1.0))
+			+ i.z + vec4(i1.z, i2.z, i3.z, 1.0))
+			+ i.y + vec4(i1.y, i2.y, i3.y, 1.0))
+			+ i.x + vec4(i1.x, i2.x, i3.x, 1.0));
+
+	vec4 ip = vec4(1.0 / 294.0, 1.0 / 49.0, 1.0 / 7.0, 0.0);
+	vec4 p0 = simplexGrad4(j0, ip);
+	vec4 p1 = simplexGrad4(j1.x, ip);
+	vec4 p2 = simplexGrad4(j1.y, ip);
+	vec4 p3 = simplexGrad4(j1.z, ip);
+	vec4 p4 = simplexGrad4(j1.w, ip);
+
+	vec4 norm = taylorInvSqrt(vec4(dot(p0, p0), dot(p1, p1), dot(p2, p2), dot(p3, p3)));
+	p0 *= norm.x;
+	p1 *= norm.y;
+	p2 *= norm.z;
+	p3 *= norm.w;
+	p4 *= taylorInvSqrt(dot(p4, p4));
+
+	vec3 m0 = max(0.6 - vec3(dot(x0, x0), dot(x1, x1), dot(x2, x2)), 0.0);
+	vec2 m1 = max(0.6 - vec2(dot(x3, x3), dot(x4, x4)), 0.0);
+	m0 = m0 * m0;
+	m1 = m1 * m1;
+	return 49.0 * (dot(m0 * m0, vec3(dot(p0, x0), dot(p1, x1), dot(p2, x2)))
+				 + dot(m1 * m1, vec2(dot(p3, x3), dot(p4, x4))));
+}
+
+/*
+** Cellular noise
+*/
+// Inigo Quilez' voronoise: u blends cells <-> grid, v blends voronoi <-> value noise
+float voronoiseIQ(vec2 p, float u, float v)
+{
+	float k = 1.0 + 63.0 * pow(1.0 - v, 6.0);
+	vec2 pi = floor(p);
+	ivec2 i = ivec2(pi);
+	vec2 f = p - pi;
+
+	vec2 a = vec2(0.0);
+	for (int y = -2; y <= 2; y++) {
+		for (int x = -2; x <= 2; x++) {
+			vec3 o = hash23(i + ivec2(x, y)) * vec3(u, u, 1.0);
+			vec2 d = vec2(x, y) - f + o.xy;
+			float w = pow(1.0 - smoothstep(0.0, 1.414, length(d)), k);
+			a += vec2(o.z * w, w);
+		}
+	}
+	return a.x / a.y;
+}
+
+// distance to the closest feature point (F1)
+float voronoiNoise(vec2 p)
+{
+	vec2 pi = floor(p);
+	ivec2 i = ivec2(pi);
+	vec2 f = p - pi;
+
+	float d2 = 8.0;
+	for (int y = -1; y <= 1; y++) {
+		for (int x = -1; x <= 1; x++) {
+			vec2 r = vec2(x, y) + hash22(i + ivec2(x, y)) - f;
+			d2 = min(d2, dot(r, r));
+		}
+	}
+	return sqrt(d2);
+}
+
+/*
+** Fractional brownian motion over the generic noise
+*/
+float fbmNoise(float x)
+{
+	float v = 0.0;
+	float a = 0.5;
+	for (int i = 0; i < THOR_FBM_OCTAVES; ++i) {
+		v += a * genericNoise(x);
+		x = x * 2.0 + 100.0;
+		a *= 0.5;
+	}
+	return v;
+}
+
+float fbmNoise(vec2 x)
+{
+	// rotate to reduce axial bias
+	const mat2 rot = mat2(0.87758256189, 0.4794255386, -0.4794255386, 0.87758256189);
+	float v = 0.0;
+	float a = 0.5;
+	for (int i = 0; i < THOR_FBM_OCTAVES; ++i) {
+		v += a * genericNoise(x);
+		x = rot * x * 2.0 + vec2(100.0);
+		a *= 0.5;
+	}
+	return v;
+}
+
+float fbmNoise(vec3 x)
+{
+	float v = 0.0;
+	float a = 0.5;
+	for (int i = 0; i < THOR_FBM_OCTAVES; ++i) {
+		v += a * genericNoise(x);
+		x = x * 2.0 + vec3(100.0);
+		a *= 0.5;
+	}
+	return v;
+}
+
+// Inigo Quilez' fbm: H is the Hurst exponent, the gain is 2^-H
+float fbmNoiseIQ(vec2 x, float H, int octaves)
+{
+	float G = exp2(-H);
+	float f = 1.0;
+	float a = 1.0;
+	float t = 0.0;
+	float norm = 0.0;
+	for (int i = 0; i < octaves; ++i) {
+		t += a * genericNoise(f * x);
+		norm += a;
+		f *= 2.0;
+		a *= G;
+	}
+	return t / norm;
+}
+
+/*
+** Layer evaluation
+*/
+vec4 layerValues(int layer)	{ return noiseLayers[2 * layer]; }
+vec4 layerShape(int layer)	{ return noiseLayers[2 * layer + 1]; }
+
+// noise space position of this pixel for a layer, offset by its VALUE_1/VALUE_2
+vec2 layerPosition(int layer, vec2 pixel)
+{
+	return pixel * (layerShape(layer).x * THOR_PIXEL_SCALE) + layerValues(layer).xy * THOR_VALUE_SCALE;
+}
+
+// composite a grey noise layer (range 0..1) over the running colour by its MIX
+void compositeLayer(inout vec4 colour, int layer, float noise)
+{
+	colour = mix(colour, vec4(vec3(clamp(noise, 0.0, 1.0)), 1.0), layerShape(layer).y);
+}
+
+void main( void )
+{
+#ifdef THOR_GENERATOR_ON
+	// a layer with a full MIX hides the input, none is uploaded
+	colourOut = vec4(0.0);
+#else
+	// the input texture holds this tile only, texel for texel
+	colourOut = texelFetch( videoTexture, ivec2(gl_FragCoord.xy), 0 );
+#endif
+
+	// in case of 16 bits, convert 32768->65535
+	colourOut = colourOut * multiplier16bit;
+
+	// swizzle ARGB to RGBA
+	colourOut = vec4(colourOut.g, colourOut.b, colourOut.a, colourOut.r);
+
+	// integer pixel coordinates in the layer, the frame buffer has the same row order as the AE world
+	vec2 pixel = gl_FragCoord.xy - 0.5 + tileOffset;
+	vec2 p;
+
+	// composite every enabled noise layer, in toggle order
+#ifdef THOR_GENERIC_1D_ON
+	{
+		p = layerPosition(NOISE_LAYER_GENERIC_1D, pixel);
+		compositeLayer(colourOut, NOISE_LAYER_GENERIC_1D, genericNoise(p.x));
+	}
+#endif
+#ifdef THOR_GENERIC_2D_ON
+	{
+		p = layerPosition(NOISE_LAYER_GENERIC_2D, pixel);
+		compositeLayer(colourOut, NOISE_LAYER_GENERIC_2D, genericNoise(p));
+	}
+#endif
+#ifdef THOR_GENERIC_3D_ON
+	{
+		p = layerPosition(NOISE_LAYER_GENERIC_3D, pixel);
+		compositeLayer(colourOut, NOISE_LAYER_GENERIC_3D,
+			genericNoise(vec3(p, layerValues(NOISE_LAYER_GENERIC_3D).z * THOR_VALUE_SCALE)));
+	}
+#endif
+#ifdef THOR_PERLIN_2D_ON
+	{
+		// DIM picks the number of octaves (1..8), FREQ the base frequency
+		vec4 shape = layerShape(NOISE_LAYER_PERLIN_2D);
+		int octaves = 1 + int(shape.z * 7.0);
+		float freq = 0.25 + shape.w * 3.75;
+		float n = 0.0;
+		float amp = 1.0;
+		float norm = 0.0;
+		p = layerPosition(NOISE_LAYER_PERLIN_2D, pixel) * freq;
+		for (int i = 0; i < octaves; ++i) {
+			n += amp * perlinNoise(p);
+			norm += amp;
+			amp *= 0.5;
+			p *= 2.0;
+		}
+)GLSL"
+R"GLSL(		compositeLayer(colourOut, NOISE_LAYER_PERLIN_2D, 0.5 + 0.5 * n / norm);
+	}
+#endif
+#ifdef THOR_PERLIN_3D_ON
+	{
+		p = layerPosition(NOISE_LAYER_PERLIN_3D, pixel);
+		compositeLayer(colourOut, NOISE_LAYER_PERLIN_3D,
+			0.5 + 0.5 * perlinNoise(vec3(p, layerValues(NOISE_LAYER_PERLIN_3D).z * THOR_VALUE_SCALE)));
+	}
+#endif
+#ifdef THOR_PERLIN_4D_ON
+	{
+		p = layerPosition(NOISE_LAYER_PERLIN_4D, pixel);
+		compositeLayer(colourOut, NOISE_LAYER_PERLIN_4D,
+			0.5 + 0.5 * perlinNoise(vec4(p, layerValues(NOISE_LAYER_PERLIN_4D).zw * THOR_VALUE_SCALE)));
+	}
+#endif
+#ifdef THOR_SIMPLEX_2D_ON
+	{
+		p = layerPosition(NOISE_LAYER_SIMPLEX_2D, pixel);
+		compositeLayer(colourOut, NOISE_LAYER_SIMPLEX_2D, 0.5 + 0.5 * simplexNoise(p));
+	}
+#endif
+#ifdef THOR_SIMPLEX_3D_ON
+	{
+		p = layerPosition(NOISE_LAYER_SIMPLEX_3D, pixel);
+		compositeLayer(colourOut, NOISE_LAYER_SIMPLEX_3D,
+			0.5 + 0.5 * simplexNoise(vec3(p, layerValues(NOISE_LAYER_SIMPLEX_3D).z * THOR_VALUE_SCALE)));
+	}
+#endif
+#ifdef THOR_SIMPLEX_4D_ON
+	{
+		p = layerPosition(NOISE_LAYER_SIMPLEX_4D, pixel);
+		compositeLayer(colourOut, NOISE_LAYER_SIMPLEX_4D,
+			0.5 + 0.5 * simplexNoise(vec4(p, layerValues(NOISE_LAYER_SIMPLEX_4D).zw * THOR_VALUE_SCALE)));
+	}
+#endif
+#ifdef THOR_VIQ_2D_ON
+	{
+		vec4 shape = layerShape(NOISE_LAYER_VIQ_2D);
+		p = layerPosition(NOISE_LAYER_VIQ_2D, pixel);
+		compositeLayer(colourOut, NOISE_LAYER_VIQ_2D, voronoiseIQ(p, shape.z, shape.w));
+	}
+#endif
+#ifdef THOR_VORONOI_2D_ON
+	{
+		p = layerPosition(NOISE_LAYER_VORONOI_2D, pixel);
+		compositeLayer(colourOut, NOISE_LAYER_VORONOI_2D, voronoiNoise(p));
+	}
+#endif
+#ifdef THOR_FRACTBROWN_1D_ON
+	{
+		p = layerPosition(NOISE_LAYER_FRACTBROWN_1D, pixel);
+		compositeLayer(colourOut, NOISE_LAYER_FRACTBROWN_1D, fbmNoise(p.x));
+	}
+#endif
+#ifdef THOR_FRACTBROWN_2D_ON
+	{
+		p = layerPosition(NOISE_LAYER_FRACTBROWN_2D, pixel);
+		compositeLayer(colourOut, NOISE_LAYER_FRACTBROWN_2D, fbmNoise(p));
+	}
+#endif
+#ifdef THOR_FRACTBROWN_3D_ON
+	{
+		p = layerPosition(NOISE_LAYER_FRACTBROWN_3D, pixel);
+		compositeLayer(colourOut, NOISE_LAYER_FRACTBROWN_3D,
+			fbmNoise(vec3(p, layerValues(NOISE_LAYER_FRACTBROWN_3D).z * THOR_VALUE_SCALE)));
+	}
+#endif
+#ifdef THOR_FRACTBROWN_IQ_ON
+	{
+		// VALUE_3 is the Hurst exponent, VALUE_4 the number of octaves (1..8)
+		vec4 values = layerValues(NOISE_LAYER_FRACTBROWN_IQ);
+		p = layerPosition(NOISE_LAYER_FRACTBROWN_IQ, pixel);
+		compositeLayer(colourOut, NOISE_LAYER_FRACTBROWN_IQ, fbmNoiseIQ(p, values.z, 1 + int(values.w * 7.0)));
+	}
+#endif
+
+	// - the layers were composited in straight alpha, which is what AE expects back
+	// - fully transparent pixels carry no colour
+	if (colourOut.a == 0.0) {
+		colourOut = vec4(0.0);
+	}
+
+	// swizzle RGBA back to ARGB, and in case of 16 bits convert 65535->32768
+	colourOut = vec4(colourOut.a, colourOut.r, colourOut.g, colourOut.b) / multiplier16bit;
+}
+)GLSL"
+;
+
+struct AESDK_OpenGL_EmbeddedShader
+{
+	const char* mNameP;
+	const char* mSourceP;
+};
+
+constexpr AESDK_OpenGL_EmbeddedShader kEmbeddedShaders[] = {
+	{ "vertex_shader.vert", kShader_vertex_shader_vert },
+	{ "fragment_shader.frag", kShader_fragment_shader_frag }
+};
+
+}
+
+#endif // GLATOR_SHADERS_H
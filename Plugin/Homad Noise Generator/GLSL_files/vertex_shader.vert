@@ -3,7 +3,15 @@ in vec4 Position;
 in vec2 UVs;
 out vec4 out_pos;
 out vec2 out_uvs;
-uniform mat4 ModelviewProjection;
+// - per render values, in a uniform buffer of the render context: the program is shared by all contexts
+// - mirrors RenderBlock (GLator.cpp)
+layout(std140) uniform RenderParams
+{
+	mat4 ModelviewProjection;
+	// position of the rendered tile in the layer, in pixels
+	vec2 tileOffset;
+	float multiplier16bit;
+};
 
 void main( void )
 {
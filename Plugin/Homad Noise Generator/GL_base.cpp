@@ -31,6 +31,7 @@
 */
 
 #include "GL_base.h"
+#include "GLSL_files/GLator_Shaders.h"
 
 #include <glbinding/callbacks.h>
 #include <glbinding/Meta.h>
@@ -40,7 +41,12 @@
 #include <glbinding/AbstractFunction.h>
 
 #include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <vector>
 #include <sstream>
 #include <iostream>
 
@@ -323,7 +329,7 @@ namespace AESDK_OpenGL
 	#endif
 
 		// VBO quad
-		GLuint CreateQuad(u_int16 widthL, u_int16 heightL)
+		GLuint CreateQuad(gl::GLsizei widthL, gl::GLsizei heightL)
 		{
 			// X, Y, X, U, V
 			float positions[] = {
@@ -341,6 +347,189 @@ namespace AESDK_OpenGL
 			return vbo;
 		}
 
+		// - hand the shader source to the compiler with extra #defines
+		// - GLSL wants #version first, so the defines go right after that line
+		void ShaderSourceWithDefines(GLuint shaderSu, const char* sourceP, const std::string& defines)
+		{
+			const char* versionEndP = strchr(sourceP, '\n');
+			if (defines.empty() || strncmp(sourceP, "#version", 8) != 0 || versionEndP == NULL) {
+				glShaderSource(shaderSu, 1, &sourceP, NULL);
+				return;
+			}
+
+			const char* stringsP[3] = { sourceP, defines.c_str(), versionEndP + 1 };
+			GLint lengths[3] = { static_cast<GLint>(versionEndP + 1 - sourceP), static_cast<GLint>(defines.size()), -1 };
+			glShaderSource(shaderSu, 3, stringsP, lengths);
+		}
+
+		/*
+		** On-disk program binary cache
+		** - one file per program, named after the hash of its sources and of the driver
+		** - the header repeats what the name was derived from, so a stale or truncated
+		**   entry is detected and rebuilt from source
+		*/
+		const uint32_t kProgramBinaryMagic = 0x42474E48; // "HNGB"
+		const uint32_t kProgramBinaryVersion = 1;
+
+		struct ProgramBinaryHeader
+		{
+			uint32_t magic;
+			uint32_t version;
+			uint64_t sourceHash;
+			uint32_t signatureLength;	// driver signature follows the header
+			uint32_t binaryFormat;
+			uint32_t binaryLength;		// program binary follows the signature
+			uint32_t reserved;
+		};
+
+		// 64 bit FNV-1a
+		uint64_t HashBytes(uint64_t hash, const void* dataP, size_t size)
+		{
+			const unsigned char* bytesP = static_cast<const unsigned char*>(dataP);
+			for (size_t i = 0; i < size; ++i) {
+				hash ^= bytesP[i];
+				hash *= 0x100000001b3ULL;
+			}
+			return hash;
+		}
+
+		uint64_t HashString(uint64_t hash, const std::string& str)
+		{
+			// hash the terminator too, so that ("ab", "c") and ("a", "bc") differ
+			return HashBytes(hash, str.c_str(), str.size() + 1);
+		}
+
+		// binaries are only valid for the exact driver that produced them
+		std::string GetDriverSignature()
+		{
+			const char* rendererP = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+			const char* versionP = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+			return std::string(rendererP ? rendererP : "") + "|" + std::string(versionP ? versionP : "");
+		}
+
+		bool ProgramBinarySupported()
+		{
+			GLint numFormats = 0;
+			glGetIntegerv(gl::GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+			return numFormats > 0;
+		}
+
+		FILE* OpenBinaryFile(const std::string& inFilename, const char* inModeP)
+		{
+			FILE *fileP = NULL;
+#ifdef AE_OS_WIN
+			fopen_s(&fileP, inFilename.c_str(), inModeP);
+#elif defined(AE_OS_MAC)
+			fileP = fopen(inFilename.c_str(), inModeP);
+#endif
+			return fileP;
+		}
+
+		// returns 0 when the entry is missing, stale or rejected by the driver
+		GLuint LoadProgramBinary(const std::string& inFilename, uint64_t inSourceHash, const std::string& inSignature)
+		{
+			FILE *fileP = OpenBinaryFile(inFilename, "rb");
+			if (fileP == NULL) {
+				return 0;
+			}
+
+			ProgramBinaryHeader header;
+			std::string signature;
+			std::vector<char> binary;
+			bool validB = fread(&header, sizeof(header), 1, fileP) == 1 &&
+						  header.magic == kProgramBinaryMagic &&
+						  header.version == kProgramBinaryVersion &&
+						  header.sourceHash == inSourceHash &&
+						  header.signatureLength == inSignature.size() &&
+						  header.binaryLength > 0;
+			if (validB) {
+				signature.resize(header.signatureLength);
+				binary.resize(header.binaryLength);
+				validB = (signature.empty() || fread(&signature[0], 1, signature.size(), fileP) == signature.size()) &&
+						 signature == inSignature &&
+						 fread(&binary[0], 1, binary.size(), fileP) == binary.size();
+			}
+			fclose(fileP);
+
+			if (!validB) {
+				return 0;
+			}
+
+			GLuint programObjSu = glCreateProgram();
+			gl::glProgramBinary(programObjSu, static_cast<gl::GLenum>(header.binaryFormat), &binary[0], static_cast<GLsizei>(binary.size()));
+
+			GLint linkedB = 0;
+			glGetProgramiv(programObjSu, GL_LINK_STATUS, &linkedB);
+			if (!linkedB) {
+				// the driver was updated in place or the file is corrupt
+				glDeleteProgram(programObjSu);
+				return 0;
+			}
+			return programObjSu;
+		}
+
+		// best effort - a read only resource folder simply disables the cache
+		void SaveProgramBinary(const std::string& inFilename, GLuint inProgramSu, uint64_t inSourceHash, const std::string& inSignature)
+		{
+			GLint binaryLength = 0;
+			glGetProgramiv(inProgramSu, gl::GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+			if (binaryLength <= 0) {
+				return;
+			}
+
+			std::vector<char> binary(binaryLength);
+			GLsizei writtenLength = 0;
+			gl::GLenum binaryFormat = gl::GLenum(0);
+			gl::glGetProgramBinary(inProgramSu, binaryLength, &writtenLength, &binaryFormat, &binary[0]);
+			if (writtenLength <= 0) {
+				return;
+			}
+
+			ProgramBinaryHeader header;
+			memset(&header, 0, sizeof(header));
+			header.magic = kProgramBinaryMagic;
+			header.version = kProgramBinaryVersion;
+			header.sourceHash = inSourceHash;
+			header.signatureLength = static_cast<uint32_t>(inSignature.size());
+			header.binaryFormat = static_cast<uint32_t>(binaryFormat);
+			header.binaryLength = static_cast<uint32_t>(writtenLength);
+
+			// write aside and rename, so that another process never reads a partial entry
+			std::string tempFilename = inFilename + ".tmp";
+			FILE *fileP = OpenBinaryFile(tempFilename, "wb");
+			if (fileP == NULL) {
+				return;
+			}
+			bool writtenB = fwrite(&header, sizeof(header), 1, fileP) == 1 &&
+							fwrite(inSignature.c_str(), 1, inSignature.size(), fileP) == inSignature.size() &&
+							fwrite(&binary[0], 1, writtenLength, fileP) == static_cast<size_t>(writtenLength);
+			writtenB = (fclose(fileP) == 0) && writtenB;
+
+			if (writtenB) {
+				remove(inFilename.c_str());
+				writtenB = rename(tempFilename.c_str(), inFilename.c_str()) == 0;
+			}
+			if (!writtenB) {
+				remove(tempFilename.c_str());
+			}
+		}
+
+		// blocks until the GPU passed the fence and deletes it, true if it was not signaled yet
+		bool WaitAndDeleteFence(gl::GLsync& ioFence)
+		{
+			gl::GLenum waitResult = glClientWaitSync(ioFence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+			bool waitedB = waitResult == GL_TIMEOUT_EXPIRED;
+			while (waitResult == GL_TIMEOUT_EXPIRED) {
+				waitResult = glClientWaitSync(ioFence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); // 1ms
+			}
+			glDeleteSync(ioFence);
+			ioFence = 0;
+			if (waitResult == GL_WAIT_FAILED) {
+				GL_CHECK(AESDK_OpenGL_Res_Load_Err);
+			}
+			return waitedB;
+		}
+
 	} // namespace anonymous
 
 /*
@@ -436,6 +625,379 @@ void AESDK_OpenGL_EffectCommonData::SetPluginContext()
 	glbinding::Binding::useCurrentContext();
 }
 
+void AESDK_OpenGL_EffectCommonData::ClearPluginContext()
+{
+#ifdef AE_OS_MAC
+	ScopedAutoreleasePool pool;
+	if (mRC && CGLGetCurrentContext() == mRC) {
+		makeCurrentFlush(NULL);
+	}
+	if (mNSOpenGLContext && [NSOpenGLContext currentContext] == mNSOpenGLContext) {
+		[NSOpenGLContext clearCurrentContext];
+	}
+#elif defined (AE_OS_WIN)
+	if (mHRC != NULL && wglGetCurrentContext() == mHRC) {
+		wglMakeCurrent(NULL, NULL);
+	}
+#endif
+}
+
+
+/*
+* AESDK_OpenGL_TexturePool
+*/
+
+AESDK_OpenGL_TexturePool::AESDK_OpenGL_TexturePool() :
+	mFrame(0),
+	mHits(0),
+	mMisses(0)
+{
+}
+
+AESDK_OpenGL_TexturePool::~AESDK_OpenGL_TexturePool()
+{
+	Clear();
+}
+
+gl::GLuint AESDK_OpenGL_TexturePool::Acquire(gl::GLsizei inWidth, gl::GLsizei inHeight, gl::GLenum inInternalFormat)
+{
+	PooledTexture pooled;
+
+	std::vector<PooledTexture>::iterator it = mFree.begin();
+	for (; it != mFree.end(); ++it) {
+		if (it->mWidth == inWidth && it->mHeight == inHeight && it->mInternalFormat == inInternalFormat) {
+			break;
+		}
+	}
+
+	if (it != mFree.end()) {
+		++mHits;
+		pooled = *it;
+		mFree.erase(it);
+	} else {
+		++mMisses;
+		pooled.mWidth = inWidth;
+		pooled.mHeight = inHeight;
+		pooled.mInternalFormat = inInternalFormat;
+
+		glGenTextures(1, &pooled.mTexture);
+		glBindTexture(GL_TEXTURE_2D, pooled.mTexture);
+
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, (GLint)GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, (GLint)GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, (GLint)GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, (GLint)GL_CLAMP_TO_EDGE);
+
+		glTexImage2D(GL_TEXTURE_2D, 0, (GLint)inInternalFormat, inWidth, inHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+
+	pooled.mLastUsedFrame = mFrame;
+	mInUse.push_back(pooled);
+	return pooled.mTexture;
+}
+
+void AESDK_OpenGL_TexturePool::Release(gl::GLuint inTexture)
+{
+	for (std::vector<PooledTexture>::iterator it = mInUse.begin(); it != mInUse.end(); ++it) {
+		if (it->mTexture == inTexture) {
+			it->mLastUsedFrame = mFrame;
+			mFree.push_back(*it);
+			mInUse.erase(it);
+			return;
+		}
+	}
+}
+
+void AESDK_OpenGL_TexturePool::EndFrame(u_long inMaxIdleFrames)
+{
+	++mFrame;
+
+	for (size_t i = 0; i < mFree.size(); ) {
+		if (mFrame - mFree[i].mLastUsedFrame > inMaxIdleFrames) {
+			glDeleteTextures(1, &mFree[i].mTexture);
+			mFree[i] = mFree.back();
+			mFree.pop_back();
+		} else {
+			++i;
+		}
+	}
+}
+
+void AESDK_OpenGL_TexturePool::Clear()
+{
+	for (size_t i = 0; i < mFree.size(); ++i) {
+		glDeleteTextures(1, &mFree[i].mTexture);
+	}
+	for (size_t i = 0; i < mInUse.size(); ++i) {
+		glDeleteTextures(1, &mInUse[i].mTexture);
+	}
+	mFree.clear();
+	mInUse.clear();
+}
+
+/*
+* AESDK_OpenGL_UploadRing
+*/
+
+AESDK_OpenGL_UploadRing::AESDK_OpenGL_UploadRing() :
+	mNext(0),
+	mWaits(0)
+{
+	for (u_long i = 0; i < AESDK_OpenGL_UploadRingSize; ++i) {
+		mSlots[i].mBuffer = 0;
+		mSlots[i].mSize = 0;
+		mSlots[i].mFence = 0;
+	}
+}
+
+AESDK_OpenGL_UploadRing::~AESDK_OpenGL_UploadRing()
+{
+	Clear();
+}
+
+void AESDK_OpenGL_UploadRing::Upload(gl::GLuint inTexture, gl::GLsizei inWidth, gl::GLsizei inHeight, gl::GLenum inType,
+									 size_t inPixelSize, const void* inSrcP, size_t inRowBytes)
+{
+	Slot& slot = mSlots[mNext];
+	mNext = (mNext + 1) % AESDK_OpenGL_UploadRingSize;
+
+	// wait for the transfer that last read this buffer, usually long done
+	if (slot.mFence && WaitAndDeleteFence(slot.mFence)) {
+		++mWaits;
+	}
+
+	// - the rows are packed tightly at the width uploaded, whatever the source's row length
+	// - the buffers only grow with the tile size, never with the frame
+	const size_t rowSize = inWidth * inPixelSize;
+	size_t uploadSize = rowSize * inHeight;
+
+	if (slot.mBuffer == 0) {
+		glGenBuffers(1, &slot.mBuffer);
+	}
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.mBuffer);
+	if (slot.mSize < uploadSize) {
+		glBufferData(GL_PIXEL_UNPACK_BUFFER, uploadSize, nullptr, GL_STREAM_DRAW);
+		slot.mSize = uploadSize;
+	}
+
+	// the fence says the GPU is done with the buffer, no need for the driver to check again
+	void* dstP = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, uploadSize,
+								  GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+	if (!dstP) {
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		GL_CHECK(AESDK_OpenGL_Res_Load_Err);
+	}
+	// a row at a time, unless the source rows are as tight as the buffer's
+	if (inRowBytes == rowSize) {
+		::memcpy(dstP, inSrcP, uploadSize);
+	} else {
+		for (gl::GLsizei row = 0; row < inHeight; ++row) {
+			::memcpy(static_cast<char*>(dstP) + row * rowSize, static_cast<const char*>(inSrcP) + row * inRowBytes, rowSize);
+		}
+	}
+	if (glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_FALSE) {
+		// the store was lost (e.g. display mode change), the texture would be garbage
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		GL_CHECK(AESDK_OpenGL_Res_Load_Err);
+	}
+
+	// the transfer reads from the bound buffer, the pointer is an offset into it
+	glBindTexture(GL_TEXTURE_2D, inTexture);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, inWidth, inHeight, GL_RGBA, inType, nullptr);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+	slot.mFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, GL_NONE_BIT);
+}
+
+void AESDK_OpenGL_UploadRing::Clear()
+{
+	for (u_long i = 0; i < AESDK_OpenGL_UploadRingSize; ++i) {
+		if (mSlots[i].mFence) {
+			glDeleteSync(mSlots[i].mFence);
+		}
+		if (mSlots[i].mBuffer) {
+			glDeleteBuffers(1, &mSlots[i].mBuffer);
+		}
+		mSlots[i].mBuffer = 0;
+		mSlots[i].mSize = 0;
+		mSlots[i].mFence = 0;
+	}
+	mNext = 0;
+}
+
+/*
+* AESDK_OpenGL_ReadbackRing
+*/
+
+AESDK_OpenGL_ReadbackRing::AESDK_OpenGL_ReadbackRing()
+{
+	for (u_long i = 0; i < AESDK_OpenGL_ReadbackRingSize; ++i) {
+		mSlots[i].mBuffer = 0;
+		mSlots[i].mSize = 0;
+		mSlots[i].mFence = 0;
+	}
+}
+
+AESDK_OpenGL_ReadbackRing::~AESDK_OpenGL_ReadbackRing()
+{
+	Clear();
+}
+
+void AESDK_OpenGL_ReadbackRing::Read(gl::GLsizei inWidth, gl::GLsizei inHeight, gl::GLenum inType,
+									 size_t inPixelSize, void* outDstP, size_t inRowBytes)
+{
+	const gl::GLsizei stripRows = AESDK_OpenGL_ReadbackStripRows;
+	const gl::GLsizei numStrips = (inHeight + stripRows - 1) / stripRows;
+
+	// - strips are packed tightly at the width read, whatever the destination's row length
+	// - the buffers only grow with the tile size, never with the frame
+	const size_t rowSize = inWidth * inPixelSize;
+	size_t stripSize = rowSize * stripRows;
+	for (u_long i = 0; i < AESDK_OpenGL_ReadbackRingSize; ++i) {
+		if (mSlots[i].mBuffer == 0) {
+			glGenBuffers(1, &mSlots[i].mBuffer);
+		}
+		if (mSlots[i].mSize < stripSize) {
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, mSlots[i].mBuffer);
+			glBufferData(GL_PIXEL_PACK_BUFFER, stripSize, nullptr, GL_STREAM_READ);
+			mSlots[i].mSize = stripSize;
+		}
+	}
+	// - queue the first strips, then copy strip i out while the GPU transfers the ones after it
+	// - the read framebuffer must be bound by the caller
+	for (gl::GLsizei strip = 0; strip < numStrips + static_cast<gl::GLsizei>(AESDK_OpenGL_ReadbackRingSize); ++strip) {
+		if (strip < numStrips) {
+			Slot& slot = mSlots[strip % AESDK_OpenGL_ReadbackRingSize];
+			gl::GLsizei firstRow = strip * stripRows;
+			gl::GLsizei rows = std::min(stripRows, inHeight - firstRow);
+
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.mBuffer);
+			glReadPixels(0, firstRow, inWidth, rows, GL_RGBA, inType, nullptr);
+			slot.mFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, GL_NONE_BIT);
+		}
+
+		gl::GLsizei readyStrip = strip - static_cast<gl::GLsizei>(AESDK_OpenGL_ReadbackRingSize) + 1;
+		if (readyStrip < 0 || readyStrip >= numStrips) {
+			continue;
+		}
+
+		Slot& slot = mSlots[readyStrip % AESDK_OpenGL_ReadbackRingSize];
+		gl::GLsizei firstRow = readyStrip * stripRows;
+		gl::GLsizei rows = std::min(stripRows, inHeight - firstRow);
+		size_t copySize = rowSize * rows;
+
+		WaitAndDeleteFence(slot.mFence);
+
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.mBuffer);
+		const void* srcP = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, copySize, GL_MAP_READ_BIT);
+		if (!srcP) {
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+			GL_CHECK(AESDK_OpenGL_Res_Load_Err);
+		}
+		// a row at a time, unless the destination rows are as tight as the strip's
+		char* dstP = static_cast<char*>(outDstP) + firstRow * inRowBytes;
+		if (inRowBytes == rowSize) {
+			::memcpy(dstP, srcP, copySize);
+		} else {
+			for (gl::GLsizei row = 0; row < rows; ++row) {
+				::memcpy(dstP + row * inRowBytes, static_cast<const char*>(srcP) + row * rowSize, rowSize);
+			}
+		}
+		glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+	}
+
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+void AESDK_OpenGL_ReadbackRing::Clear()
+{
+	for (u_long i = 0; i < AESDK_OpenGL_ReadbackRingSize; ++i) {
+		if (mSlots[i].mFence) {
+			glDeleteSync(mSlots[i].mFence);
+		}
+		if (mSlots[i].mBuffer) {
+			glDeleteBuffers(1, &mSlots[i].mBuffer);
+		}
+		mSlots[i].mBuffer = 0;
+		mSlots[i].mSize = 0;
+		mSlots[i].mFence = 0;
+	}
+}
+
+/*
+* AESDK_OpenGL_WorkerPool
+*/
+
+AESDK_OpenGL_WorkerPool::AESDK_OpenGL_WorkerPool() :
+	mStopping(false)
+{
+}
+
+AESDK_OpenGL_WorkerPool::~AESDK_OpenGL_WorkerPool()
+{
+	Stop();
+}
+
+void AESDK_OpenGL_WorkerPool::Start(size_t inWorkers)
+{
+	Stop();
+
+	mStopping = false;
+	for (size_t i = 0; i < inWorkers; ++i) {
+		mWorkers.push_back(std::thread(&AESDK_OpenGL_WorkerPool::WorkerLoop, this));
+	}
+}
+
+void AESDK_OpenGL_WorkerPool::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mStopping = true;
+	}
+	mJobAvailable.notify_all();
+
+	for (size_t i = 0; i < mWorkers.size(); ++i) {
+		mWorkers[i].join();
+	}
+	mWorkers.clear();
+}
+
+std::future<void> AESDK_OpenGL_WorkerPool::Submit(const std::function<void()>& inJob)
+{
+	std::packaged_task<void()> task(inJob);
+	std::future<void> result = task.get_future();
+
+	if (!IsRunning()) {
+		task();
+		return result;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mJobs.push_back(std::move(task));
+	}
+	mJobAvailable.notify_one();
+	return result;
+}
+
+void AESDK_OpenGL_WorkerPool::WorkerLoop()
+{
+	for (;;) {
+		std::packaged_task<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			mJobAvailable.wait(lock, [this]() { return mStopping || !mJobs.empty(); });
+			if (mJobs.empty()) {
+				return;
+			}
+			task = std::move(mJobs.front());
+			mJobs.pop_front();
+		}
+		// exceptions end up in the future
+		task();
+	}
+}
 
 /*
 * AESDK_OpenGL_EffectRenderData
@@ -446,9 +1008,14 @@ AESDK_OpenGL_EffectRenderData::AESDK_OpenGL_EffectRenderData() :
 	mColorRenderBufferSu(0),
 	mRenderBufferWidthSu(0),
 	mRenderBufferHeightSu(0),
-	mProgramObjSu(0),
-	mProgramObj2Su(0),
 	mOutputFrameTexture(0),
+	mOutputFrameFormat(GL_RGBA32F),
+	mParamBuffer(0),
+	mParamBlockHash(0),
+	mParamBlockSize(0),
+	mRenderBuffer(0),
+	mRenderBlockHash(0),
+	mRenderBlockSize(0),
 	vao(0),
 	quad(0)
 {
@@ -459,17 +1026,19 @@ AESDK_OpenGL_EffectRenderData::~AESDK_OpenGL_EffectRenderData()
 	SetPluginContext();
 
 	//local OpenGL resource un-loading
-	if (mOutputFrameTexture) {
-		glDeleteTextures(1, &mOutputFrameTexture);
+	mTexturePool.Clear();
+	mOutputFrameTexture = 0;
+	mUploadRing.Clear();
+	mReadbackRing.Clear();
+	if (mParamBuffer) {
+		glDeleteBuffers(1, &mParamBuffer);
+	}
+	if (mRenderBuffer) {
+		glDeleteBuffers(1, &mRenderBuffer);
 	}
 
 	//common OpenGL resource unloading
-	if (mProgramObjSu) {
-		glDeleteProgram(mProgramObjSu);
-	}
-	if (mProgramObj2Su) {
-		glDeleteProgram(mProgramObj2Su);
-	}
+	mProgramObjRef.reset();
 
 	//release framebuffer resources
 	if (mFrameBufferSu) {
@@ -487,6 +1056,378 @@ AESDK_OpenGL_EffectRenderData::~AESDK_OpenGL_EffectRenderData()
 
 }
 
+/*
+* AESDK_OpenGL_RenderContextPool
+*/
+
+// - Idle -> Leased by a compare and swap, from the owner's cache or under the pool lock
+// - Leased -> Idle by the lease holder only, Idle -> Evicted under the pool lock only, and for good:
+//   the context of a slot that is not Leased is never touched outside the lock
+struct AESDK_OpenGL_RenderContextPool::Slot
+{
+	enum { Idle, Leased, Evicted };
+
+	Slot() : mState(Leased), mOwnerKey(nullptr), mLastUsed(0) {}
+
+	std::atomic<int>					mState;
+	std::atomic<const void*>			mOwnerKey;	// token of the last lease holder, checked by the lock-free path
+	std::weak_ptr<void>					mOwner;		// the same thread, expired once it exited, under the pool lock
+	std::atomic<int64_t>				mLastUsed;	// steady clock ticks at the last release
+	AESDK_OpenGL_EffectRenderDataPtr	mContext;
+};
+
+namespace {
+	int64_t GetIdleClock()
+	{
+		return std::chrono::steady_clock::now().time_since_epoch().count();
+	}
+
+	int64_t GetIdleTicks()
+	{
+		return std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+			std::chrono::duration<double>(AESDK_OpenGL_RenderContextIdleSeconds)).count();
+	}
+
+	// - counts the thread in the pool's waiters for as long as it is in scope, exceptions included
+	// - a count left up for good would make every lock-free release take the lock
+	class ScopedWaiter
+	{
+	public:
+		explicit ScopedWaiter(std::atomic<u_long>& ioWaiters) : mWaiters(ioWaiters) { ++mWaiters; }
+		~ScopedWaiter() { --mWaiters; }
+
+	private:
+		std::atomic<u_long>& mWaiters;
+
+		ScopedWaiter(const ScopedWaiter &);
+		ScopedWaiter &operator=(const ScopedWaiter &);
+	};
+}
+
+AESDK_OpenGL_RenderContextPool::ThreadCache& AESDK_OpenGL_RenderContextPool::GetThreadCache()
+{
+	thread_local ThreadCache t_cache = { std::make_shared<int>(0), SlotPtr(), nullptr, 0 };
+	return t_cache;
+}
+
+AESDK_OpenGL_RenderContextPool::AESDK_OpenGL_RenderContextPool(size_t inCapacity) :
+	mWaiters(0),
+	mCapacity(inCapacity),
+	mCreated(0),
+	mEvicted(0)
+{
+}
+
+AESDK_OpenGL_RenderContextPool::~AESDK_OpenGL_RenderContextPool()
+{
+	Clear();
+}
+
+void AESDK_OpenGL_RenderContextPool::SetCapacity(size_t inCapacity)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	mCapacity = inCapacity;
+	mReleased.notify_all();
+}
+
+AESDK_OpenGL_EffectRenderDataPtr AESDK_OpenGL_RenderContextPool::Acquire()
+{
+	ThreadCache& cache = GetThreadCache();
+
+	// steady state: the slot this thread had last is still free, and still this thread's
+	if (cache.mPool == this && cache.mSlot) {
+		Slot& slot = *cache.mSlot;
+		int expected = Slot::Idle;
+		if (slot.mState.compare_exchange_strong(expected, Slot::Leased)) {
+			if (slot.mOwnerKey.load() == cache.mToken.get()) {
+				if (++cache.mLeases % AESDK_OpenGL_RenderContextSweepLeases == 0) {
+					std::vector<AESDK_OpenGL_EffectRenderDataPtr> evicted;
+					std::unique_lock<std::mutex> lock(mMutex, std::try_to_lock);
+					if (lock.owns_lock()) {
+						Sweep(evicted);
+						lock.unlock();
+					}
+				}
+				return slot.mContext;
+			}
+			// another thread took it over and gave it back, it decides under the lock
+			slot.mState.store(Slot::Idle);
+			NotifyReleased();
+		}
+	}
+	return AcquireLocked(cache);
+}
+
+AESDK_OpenGL_EffectRenderDataPtr AESDK_OpenGL_RenderContextPool::AcquireLocked(ThreadCache& ioCache)
+{
+	std::vector<AESDK_OpenGL_EffectRenderDataPtr> evicted;
+	SlotPtr leased;
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+		// counted before looking at the slots, so a release either sees us or happened before we look
+		ScopedWaiter waiter(mWaiters);
+
+		Sweep(evicted);
+
+		while (!leased) {
+			SlotPtr own, orphan, lru;
+			for (size_t i = 0; i < mSlots.size(); ++i) {
+				const SlotPtr& slot = mSlots[i];
+				if (slot->mState.load() != Slot::Idle) {
+					continue;
+				}
+				std::shared_ptr<void> owner = slot->mOwner.lock();
+				if (owner == ioCache.mToken) {
+					own = slot;
+					break;
+				}
+				if (!owner && (!orphan || slot->mLastUsed.load() < orphan->mLastUsed.load())) {
+					orphan = slot;
+				}
+				if (!lru || slot->mLastUsed.load() < lru->mLastUsed.load()) {
+					lru = slot;
+				}
+			}
+
+			SlotPtr candidate = own ? own : orphan;
+			if (!candidate && (mCapacity == 0 || mSlots.size() < mCapacity)) {
+				// born leased, nobody else can see it yet
+				leased.reset(new Slot());
+				leased->mContext.reset(new AESDK_OpenGL_EffectRenderData());
+				mSlots.push_back(leased);
+				++mCreated;
+				break;
+			}
+			if (!candidate) {
+				candidate = lru;
+			}
+
+			if (candidate) {
+				// a lock-free lease may have beaten us to it, look again
+				int expected = Slot::Idle;
+				if (candidate->mState.compare_exchange_strong(expected, Slot::Leased)) {
+					leased = candidate;
+				}
+			} else {
+				// every context is rendering
+				mReleased.wait(lock);
+			}
+		}
+
+		leased->mOwner = ioCache.mToken;
+		leased->mOwnerKey.store(ioCache.mToken.get());
+	}
+
+	ioCache.mSlot = leased;
+	ioCache.mPool = this;
+
+	// the GL objects of the evicted contexts are deleted here, outside the lock
+	evicted.clear();
+	return leased->mContext;
+}
+
+void AESDK_OpenGL_RenderContextPool::Release(const AESDK_OpenGL_EffectRenderDataPtr& inContext)
+{
+	// the lease was taken on this thread, its slot is the one in the cache
+	ThreadCache& cache = GetThreadCache();
+	if (cache.mPool == this && cache.mSlot && cache.mSlot->mContext == inContext) {
+		cache.mSlot->mLastUsed.store(GetIdleClock());
+		cache.mSlot->mState.store(Slot::Idle);
+		NotifyReleased();
+	}
+}
+
+void AESDK_OpenGL_RenderContextPool::NotifyReleased()
+{
+	// only take the lock when a thread may be waiting, see AcquireLocked
+	if (mWaiters.load() > 0) {
+		std::lock_guard<std::mutex> lock(mMutex);
+		mReleased.notify_all();
+	}
+}
+
+void AESDK_OpenGL_RenderContextPool::Sweep(std::vector<AESDK_OpenGL_EffectRenderDataPtr>& outEvicted)
+{
+	int64_t now = GetIdleClock();
+	int64_t idleTicks = GetIdleTicks();
+	for (size_t i = 0; i < mSlots.size();) {
+		Slot& slot = *mSlots[i];
+		int expected = Slot::Idle;
+		if (now - slot.mLastUsed.load() > idleTicks && slot.mState.compare_exchange_strong(expected, Slot::Evicted)) {
+			outEvicted.push_back(std::move(slot.mContext));
+			mSlots.erase(mSlots.begin() + i);
+			++mEvicted;
+		} else {
+			++i;
+		}
+	}
+}
+
+void AESDK_OpenGL_RenderContextPool::Clear()
+{
+	std::vector<AESDK_OpenGL_EffectRenderDataPtr> evicted;
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+		ScopedWaiter waiter(mWaiters);
+		for (size_t i = 0; i < mSlots.size(); ++i) {
+			Slot& slot = *mSlots[i];
+			for (;;) {
+				int expected = Slot::Idle;
+				if (slot.mState.compare_exchange_strong(expected, Slot::Evicted) || expected == Slot::Evicted) {
+					break;
+				}
+				// still rendering
+				mReleased.wait(lock);
+			}
+			evicted.push_back(std::move(slot.mContext));
+		}
+		mSlots.clear();
+	}
+}
+
+u_long AESDK_OpenGL_RenderContextPool::GetLiveCount() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return static_cast<u_long>(mSlots.size());
+}
+
+u_long AESDK_OpenGL_RenderContextPool::GetCreatedCount() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mCreated;
+}
+
+u_long AESDK_OpenGL_RenderContextPool::GetEvictedCount() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mEvicted;
+}
+
+/*
+* AESDK_OpenGL_Program
+*/
+
+AESDK_OpenGL_Program::AESDK_OpenGL_Program(gl::GLuint inProgramSu) :
+	mProgramSu(inProgramSu),
+	mVideoTextureLoc(-1),
+	mParamBlockIndex(GL_INVALID_INDEX),
+	mRenderBlockIndex(GL_INVALID_INDEX)
+{
+	mVideoTextureLoc = glGetUniformLocation(mProgramSu, "videoTexture");
+
+	// bindings are program state, so they are set up once for all contexts
+	mParamBlockIndex = glGetUniformBlockIndex(mProgramSu, "NoiseParams");
+	if (mParamBlockIndex != GL_INVALID_INDEX) {
+		glUniformBlockBinding(mProgramSu, mParamBlockIndex, AESDK_OpenGL_ParamBlockBinding);
+	}
+	mRenderBlockIndex = glGetUniformBlockIndex(mProgramSu, "RenderParams");
+	if (mRenderBlockIndex != GL_INVALID_INDEX) {
+		glUniformBlockBinding(mProgramSu, mRenderBlockIndex, AESDK_OpenGL_RenderBlockBinding);
+	}
+	if (mVideoTextureLoc != -1) {
+		GLint currentProgram = 0;
+		glGetIntegerv(GL_CURRENT_PROGRAM, &currentProgram);
+		glUseProgram(mProgramSu);
+		glUniform1i(mVideoTextureLoc, AESDK_OpenGL_VideoTextureUnit);
+		glUseProgram(static_cast<GLuint>(currentProgram));
+	}
+}
+
+AESDK_OpenGL_Program::~AESDK_OpenGL_Program()
+{
+	if (mProgramSu) {
+		glDeleteProgram(mProgramSu);
+	}
+}
+
+/*
+* AESDK_OpenGL_ProgramCache
+*/
+
+AESDK_OpenGL_ProgramCache::AESDK_OpenGL_ProgramCache(size_t inCapacity) :
+	mCapacity(inCapacity > 0 ? inCapacity : 1)
+{
+}
+
+void AESDK_OpenGL_ProgramCache::SetBinaryCachePath(const std::string& inPath)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	mBinaryCachePath = inPath;
+}
+
+void AESDK_OpenGL_ProgramCache::SetShaderOverridePath(const std::string& inPath)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	mShaderOverridePath = inPath;
+}
+
+AESDK_OpenGL_ProgramPtr AESDK_OpenGL_ProgramCache::GetProgram(u_long inKey,
+															  const std::string& inVertexShaderName,
+															  const std::string& inFragmentShaderName,
+															  const std::string& inDefines)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	std::map<u_long, ProgramList::iterator>::iterator found = mIndex.find(inKey);
+	if (found != mIndex.end()) {
+		// hit, move to the front of the LRU list
+		mPrograms.splice(mPrograms.begin(), mPrograms, found->second);
+		return mPrograms.front().second;
+	}
+
+	// miss, build while holding the lock so that two threads never build the same permutation
+	AESDK_OpenGL_ProgramPtr program(new AESDK_OpenGL_Program(BuildProgram(inVertexShaderName, inFragmentShaderName, inDefines)));
+
+	mPrograms.push_front(std::make_pair(inKey, program));
+	mIndex[inKey] = mPrograms.begin();
+
+	while (mPrograms.size() > mCapacity) {
+		mIndex.erase(mPrograms.back().first);
+		mPrograms.pop_back();
+	}
+
+	return program;
+}
+
+gl::GLuint AESDK_OpenGL_ProgramCache::BuildProgram(const std::string& inVertexShaderName,
+												   const std::string& inFragmentShaderName,
+												   const std::string& inDefines)
+{
+	std::string vertexShaderSource = AESDK_OpenGL_GetShaderSource(inVertexShaderName, mShaderOverridePath);
+	std::string fragmentShaderSource = AESDK_OpenGL_GetShaderSource(inFragmentShaderName, mShaderOverridePath);
+
+	if (mBinaryCachePath.empty() || !ProgramBinarySupported()) {
+		return AESDK_OpenGL_InitShaderFromSource(vertexShaderSource, fragmentShaderSource, inDefines);
+	}
+
+	uint64_t sourceHash = 0xcbf29ce484222325ULL;
+	sourceHash = HashString(sourceHash, vertexShaderSource);
+	sourceHash = HashString(sourceHash, fragmentShaderSource);
+	sourceHash = HashString(sourceHash, inDefines);
+
+	std::string signature = GetDriverSignature();
+
+	std::stringstream filename;
+	filename << mBinaryCachePath << "GLator_" << std::hex << HashString(sourceHash, signature) << ".glbin";
+
+	GLuint programObjSu = LoadProgramBinary(filename.str(), sourceHash, signature);
+	if (programObjSu == 0) {
+		programObjSu = AESDK_OpenGL_InitShaderFromSource(vertexShaderSource, fragmentShaderSource, inDefines, true);
+		SaveProgramBinary(filename.str(), programObjSu, sourceHash, signature);
+	}
+	return programObjSu;
+}
+
+void AESDK_OpenGL_ProgramCache::Clear()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	mIndex.clear();
+	mPrograms.clear();
+}
+
 /*
 ** OS Specific windowing context creation - essential for creating the OpenGL drawing context
 */
@@ -529,7 +1470,8 @@ void AESDK_OpenGL_Shutdown(AESDK_OpenGL_EffectCommonData& inData)
 /*
 ** OpenGL resource loading
 */
-void AESDK_OpenGL_InitResources(AESDK_OpenGL_EffectRenderData& inData, u_short inBufferWidth, u_short inBufferHeight, const std::string& resourcePath)
+void AESDK_OpenGL_InitResources(AESDK_OpenGL_EffectRenderData& inData, gl::GLsizei inBufferWidth, gl::GLsizei inBufferHeight, gl::GLenum inInternalFormat,
+								AESDK_OpenGL_ProgramCache& ioProgramCache, u_long inPermutationKey, const std::string& inPermutationDefines)
 {
 	bool sizeChangedB = inData.mRenderBufferWidthSu != inBufferWidth || inData.mRenderBufferHeightSu != inBufferHeight;
 	
@@ -550,7 +1492,7 @@ void AESDK_OpenGL_InitResources(AESDK_OpenGL_EffectRenderData& inData, u_short i
 			inData.mColorRenderBufferSu = 0;
 		}
 		if (inData.mOutputFrameTexture) {
-			glDeleteTextures(1, &inData.mOutputFrameTexture);
+			inData.mTexturePool.Release(inData.mOutputFrameTexture);
 			inData.mOutputFrameTexture = 0;
 		}
 
@@ -588,30 +1530,21 @@ void AESDK_OpenGL_InitResources(AESDK_OpenGL_EffectRenderData& inData, u_short i
 
 	//GLator effect specific OpenGL resource loading
 	//create an empty texture for the input surface
+	//the render target follows the bit depth of the frame
+	if (inData.mOutputFrameTexture != 0 && inData.mOutputFrameFormat != inInternalFormat) {
+		inData.mTexturePool.Release(inData.mOutputFrameTexture);
+		inData.mOutputFrameTexture = 0;
+	}
 	if (inData.mOutputFrameTexture == 0) {
-		glGenTextures(1, &inData.mOutputFrameTexture);
-		glBindTexture(GL_TEXTURE_2D, inData.mOutputFrameTexture);
-
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, (GLint)GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, (GLint)GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, (GLint)GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, (GLint)GL_CLAMP_TO_EDGE);
-
-		glTexImage2D(GL_TEXTURE_2D, 0, (GLint)GL_RGBA32F, inData.mRenderBufferWidthSu, inData.mRenderBufferHeightSu, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+		inData.mOutputFrameTexture = inData.mTexturePool.Acquire(inData.mRenderBufferWidthSu, inData.mRenderBufferHeightSu, inInternalFormat);
+		inData.mOutputFrameFormat = inInternalFormat;
 	}
 
-	if (inData.mProgramObjSu == 0) {
-		//initialize and compile the shader objects
-		inData.mProgramObjSu = AESDK_OpenGL_InitShader(
-			resourcePath + "vertex_shader.vert",
-			resourcePath + "fragment_shader.frag");
-	}
-	if (inData.mProgramObj2Su == 0) {
-		//initialize and compile the shader objects
-		inData.mProgramObj2Su = AESDK_OpenGL_InitShader(
-			resourcePath + "vertex_shader.vert",
-			resourcePath + "fragment_shader2.frag");
-	}
+	//the shader permutation for this render, built on first use by any thread
+	inData.mProgramObjRef = ioProgramCache.GetProgram(inPermutationKey,
+		"vertex_shader.vert",
+		"fragment_shader.frag",
+		inPermutationDefines);
 }
 
 /*
@@ -631,13 +1564,72 @@ void AESDK_OpenGL_MakeReadyToRender(AESDK_OpenGL_EffectRenderData& inData, gl::G
 		GL_CHECK(AESDK_OpenGL_Res_Load_Err);
 }
 
+/*
+** Upload a uniform block to a buffer of the render context, skipped when it didn't change since the last upload
+*/
+namespace {
+	void UpdateUniformBlock(gl::GLuint& ioBuffer, uint64_t& ioBlockHash, size_t& ioBlockSize, gl::GLuint inBinding,
+							const void* inBlockP, size_t inBlockSize)
+	{
+		uint64_t blockHash = HashBytes(0xcbf29ce484222325ULL, inBlockP, inBlockSize);
+
+		if (ioBuffer == 0) {
+			glGenBuffers(1, &ioBuffer);
+			ioBlockSize = 0;
+		}
+
+		glBindBuffer(GL_UNIFORM_BUFFER, ioBuffer);
+		if (ioBlockSize != inBlockSize) {
+			glBufferData(GL_UNIFORM_BUFFER, inBlockSize, inBlockP, GL_DYNAMIC_DRAW);
+			ioBlockSize = inBlockSize;
+			ioBlockHash = blockHash;
+		} else if (ioBlockHash != blockHash) {
+			glBufferSubData(GL_UNIFORM_BUFFER, 0, inBlockSize, inBlockP);
+			ioBlockHash = blockHash;
+		}
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+		// binding points are context state, each render context has its own buffers
+		glBindBufferBase(GL_UNIFORM_BUFFER, inBinding, ioBuffer);
+	}
+}
+
+void AESDK_OpenGL_UpdateParamBlock(AESDK_OpenGL_EffectRenderData& inData, const void* inBlockP, size_t inBlockSize)
+{
+	UpdateUniformBlock(inData.mParamBuffer, inData.mParamBlockHash, inData.mParamBlockSize, AESDK_OpenGL_ParamBlockBinding,
+					   inBlockP, inBlockSize);
+}
+
+// the per render values: with the program shared, glUniform* would race between contexts
+void AESDK_OpenGL_UpdateRenderBlock(AESDK_OpenGL_EffectRenderData& inData, const void* inBlockP, size_t inBlockSize)
+{
+	UpdateUniformBlock(inData.mRenderBuffer, inData.mRenderBlockHash, inData.mRenderBlockSize, AESDK_OpenGL_RenderBlockBinding,
+					   inBlockP, inBlockSize);
+}
+
 /*
 ** Initializing the Shader objects
 */
-gl::GLuint AESDK_OpenGL_InitShader(std::string inVertexShaderFile, std::string inFragmentShaderFile)
+gl::GLuint AESDK_OpenGL_InitShader(std::string inVertexShaderFile, std::string inFragmentShaderFile, const std::string& inDefines)
+{
+	unsigned char* vertexShaderAssemblyP = NULL;
+	if ((vertexShaderAssemblyP = ReadShaderFile(inVertexShaderFile)) == NULL) {
+		GL_CHECK(AESDK_OpenGL_ShaderInit_Err);
+	}
+	std::string vertexShaderSource((char*)vertexShaderAssemblyP);
+	delete [] vertexShaderAssemblyP;
+
+	unsigned char* fragmentShaderAssemblyP = NULL;
+	if(	(fragmentShaderAssemblyP = ReadShaderFile( inFragmentShaderFile )) == NULL)
+		GL_CHECK(AESDK_OpenGL_ShaderInit_Err);
+	std::string fragmentShaderSource((char*)fragmentShaderAssemblyP);
+	delete [] fragmentShaderAssemblyP;
+
+	return AESDK_OpenGL_InitShaderFromSource(vertexShaderSource, fragmentShaderSource, inDefines);
+}
+
+gl::GLuint AESDK_OpenGL_InitShaderFromSource(const std::string& inVertexShaderSource, const std::string& inFragmentShaderSource, const std::string& inDefines, bool inRetrievableB)
 {
-	const char *vertexShaderStringsP[1];
-	const char *fragmentShaderStringsP[1];
 	GLint vertCompiledB;
 	GLint fragCompiledB;
 	GLint linkedB;
@@ -645,38 +1637,28 @@ gl::GLuint AESDK_OpenGL_InitShader(std::string inVertexShaderFile, std::string i
 	// Create the vertex shader...
 	GLuint vertexShaderSu = glCreateShader(GL_VERTEX_SHADER);
 
-	unsigned char* vertexShaderAssemblyP = NULL;
-	if ((vertexShaderAssemblyP = ReadShaderFile(inVertexShaderFile)) == NULL) {
-		GL_CHECK(AESDK_OpenGL_ShaderInit_Err);
-	}
-
-	vertexShaderStringsP[0] = (char*)vertexShaderAssemblyP;
-	glShaderSource(vertexShaderSu, 1, vertexShaderStringsP, NULL);
+	ShaderSourceWithDefines(vertexShaderSu, inVertexShaderSource.c_str(), inDefines);
 	glCompileShader(vertexShaderSu);
-	delete vertexShaderAssemblyP;
 
 	glGetShaderiv(vertexShaderSu, GL_COMPILE_STATUS, &vertCompiledB);
 	char str[4096];
 	if(!vertCompiledB) {
 		glGetShaderInfoLog(vertexShaderSu, sizeof(str), NULL, str);
+		glDeleteShader(vertexShaderSu);
 		GL_CHECK(AESDK_OpenGL_ShaderInit_Err);
 	}
 
 	// Create the fragment shader...
 	GLuint fragmentShaderSu = glCreateShader(GL_FRAGMENT_SHADER);
 
-	unsigned char* fragmentShaderAssemblyP = NULL;
-	if(	(fragmentShaderAssemblyP = ReadShaderFile( inFragmentShaderFile )) == NULL)
-		GL_CHECK(AESDK_OpenGL_ShaderInit_Err);
-
-	fragmentShaderStringsP[0] = (char*)fragmentShaderAssemblyP;
-	glShaderSource(fragmentShaderSu, 1, fragmentShaderStringsP, NULL);
+	ShaderSourceWithDefines(fragmentShaderSu, inFragmentShaderSource.c_str(), inDefines);
 	glCompileShader(fragmentShaderSu);
-	delete fragmentShaderAssemblyP;
 
 	glGetShaderiv(fragmentShaderSu, GL_COMPILE_STATUS, &fragCompiledB);
 	if(!fragCompiledB) {
 		glGetShaderInfoLog(fragmentShaderSu, sizeof(str), NULL, str);
+		glDeleteShader(vertexShaderSu);
+		glDeleteShader(fragmentShaderSu);
 		GL_CHECK(AESDK_OpenGL_ShaderInit_Err);
 	}
 
@@ -688,20 +1670,26 @@ gl::GLuint AESDK_OpenGL_InitShader(std::string inVertexShaderFile, std::string i
 	glBindAttribLocation(programObjSu, PositionSlot, "Position");
 	glBindAttribLocation(programObjSu, UVSlot, "UVs");
 
+	// must be set before linking for glGetProgramBinary to succeed
+	if (inRetrievableB) {
+		gl::glProgramParameteri(programObjSu, gl::GL_PROGRAM_BINARY_RETRIEVABLE_HINT, 1);
+	}
+
 	// Link the program object
 	glLinkProgram(programObjSu);
 	glGetProgramiv(programObjSu, GL_LINK_STATUS, &linkedB);
 
-	if( !linkedB ) {
-		glGetProgramInfoLog(programObjSu, sizeof(str), NULL, str);
-		GL_CHECK(AESDK_OpenGL_ShaderInit_Err);
-	}
-
 	glDetachShader(programObjSu, vertexShaderSu);
 	glDetachShader(programObjSu, fragmentShaderSu);
 	glDeleteShader(vertexShaderSu);
 	glDeleteShader(fragmentShaderSu);
 
+	if( !linkedB ) {
+		glGetProgramInfoLog(programObjSu, sizeof(str), NULL, str);
+		glDeleteProgram(programObjSu);
+		GL_CHECK(AESDK_OpenGL_ShaderInit_Err);
+	}
+
 	return programObjSu;
 }
 
@@ -766,6 +1754,30 @@ std::string CheckFramebufferStatus()
 	return std::string("Unknown error!");
 }
 
+/*
+** Shader sources are compiled into the plug-in, a development folder may override them
+*/
+std::string AESDK_OpenGL_GetShaderSource(const std::string& inShaderName, const std::string& inOverridePath)
+{
+	if (!inOverridePath.empty()) {
+		unsigned char* overrideP = ReadShaderFile(inOverridePath + inShaderName);
+		if (overrideP != NULL) {
+			std::string source((char*)overrideP);
+			delete [] overrideP;
+			return source;
+		}
+	}
+
+	for (size_t i = 0; i < sizeof(kEmbeddedShaders) / sizeof(kEmbeddedShaders[0]); ++i) {
+		if (inShaderName == kEmbeddedShaders[i].mNameP) {
+			return std::string(kEmbeddedShaders[i].mSourceP);
+		}
+	}
+
+	GL_CHECK(AESDK_OpenGL_ShaderInit_Err);
+	return std::string();
+}
+
 /*
 ** ReadShaderFile
 */
@@ -783,9 +1795,10 @@ unsigned char *ReadShaderFile(std::string inFilename)
 		fseek(fileP, 0L, SEEK_END);
 		int32_t fileLength = ftell( fileP);
 		rewind(fileP);
-		bufferP = new unsigned char[fileLength];
+		bufferP = new unsigned char[fileLength + 1];
 		int32_t bytes = static_cast<int32_t>(fread( bufferP, 1, fileLength, fileP ));
 		bufferP[bytes] = 0;
+		fclose(fileP);
 
 #if defined(AE_OS_WIN) && defined(_DEBUG)
 		OutputDebugStringA((const char*)bufferP);
@@ -66,6 +66,16 @@
 #include <fstream>
 #include <memory>
 #include <set>
+#include <list>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <future>
+#include <functional>
+#include <condition_variable>
 
 //typedefs
 typedef unsigned char		u_char;
@@ -89,6 +99,8 @@ struct AESDK_OpenGL_EffectCommonData
 	// must surround plug-in OpenGL calls with these functions so that AE
 	// doesn't know we're borrowing the OpenGL renderer
 	void SetPluginContext();
+	// unbinds the context from this thread if it is current there, so that another thread can make it current
+	void ClearPluginContext();
 
 	bool mInitialized;
 	std::set<gl::GLextension> mExtensions;
@@ -108,6 +120,242 @@ struct AESDK_OpenGL_EffectCommonData
 
 typedef std::shared_ptr<AESDK_OpenGL_EffectCommonData> AESDK_OpenGL_EffectCommonDataPtr;
 
+/*
+// Linked program object, shared by all the contexts of the share group
+*/
+
+struct AESDK_OpenGL_Program
+{
+	explicit AESDK_OpenGL_Program(gl::GLuint inProgramSu);
+	~AESDK_OpenGL_Program(); // a context of the share group must be current
+
+	gl::GLuint mProgramSu;
+
+	// - resolved once after linking, -1 when the program doesn't use them
+	// - the program only holds state that never changes, per render values go through uniform buffers
+	gl::GLint mVideoTextureLoc;
+	gl::GLuint mParamBlockIndex;	// GL_INVALID_INDEX when unused
+	gl::GLuint mRenderBlockIndex;	// GL_INVALID_INDEX when unused
+
+private:
+	AESDK_OpenGL_Program(const AESDK_OpenGL_Program &);
+	AESDK_OpenGL_Program &operator=(const AESDK_OpenGL_Program &);
+};
+
+typedef std::shared_ptr<AESDK_OpenGL_Program> AESDK_OpenGL_ProgramPtr;
+
+// uniform buffer binding points of the "NoiseParams" and "RenderParams" blocks, and texture unit of "videoTexture"
+const gl::GLuint AESDK_OpenGL_ParamBlockBinding = 0;
+const gl::GLuint AESDK_OpenGL_RenderBlockBinding = 1;
+const gl::GLint AESDK_OpenGL_VideoTextureUnit = 0;
+
+/*
+// LRU bounded cache of shader permutations, shared by the render threads
+// - a permutation is identified by the key of the #defines it is compiled with
+// - evicted programs stay alive until the last context using them lets go
+*/
+
+class AESDK_OpenGL_ProgramCache
+{
+public:
+	explicit AESDK_OpenGL_ProgramCache(size_t inCapacity);
+
+	AESDK_OpenGL_ProgramPtr GetProgram(u_long inKey,
+									   const std::string& inVertexShaderName,
+									   const std::string& inFragmentShaderName,
+									   const std::string& inDefines);
+	void Clear();
+
+	// folder for the on-disk program binaries, empty to always compile from source
+	void SetBinaryCachePath(const std::string& inPath);
+	// development folder whose shader files replace the embedded ones, empty for none
+	void SetShaderOverridePath(const std::string& inPath);
+
+private:
+	typedef std::list<std::pair<u_long, AESDK_OpenGL_ProgramPtr> > ProgramList;
+
+	gl::GLuint BuildProgram(const std::string& inVertexShaderName,
+							const std::string& inFragmentShaderName,
+							const std::string& inDefines);
+
+	std::mutex mMutex;
+	size_t mCapacity;
+	std::string mBinaryCachePath;
+	std::string mShaderOverridePath;
+	ProgramList mPrograms; // most recently used first
+	std::map<u_long, ProgramList::iterator> mIndex;
+
+	AESDK_OpenGL_ProgramCache(const AESDK_OpenGL_ProgramCache &);
+	AESDK_OpenGL_ProgramCache &operator=(const AESDK_OpenGL_ProgramCache &);
+};
+
+/*
+// Per render context pool of 2D textures, recycled by size and internal format
+// - textures are not shared between threads, so the pool is not locked
+// - free textures not reused for AESDK_OpenGL_TexturePoolIdleFrames renders are deleted
+*/
+
+const u_long AESDK_OpenGL_TexturePoolIdleFrames = 16;
+
+class AESDK_OpenGL_TexturePool
+{
+public:
+	AESDK_OpenGL_TexturePool();
+	~AESDK_OpenGL_TexturePool(); // the owning context must be current
+
+	// storage is only allocated on a miss, the caller re-specifies the content with glTexSubImage2D
+	gl::GLuint Acquire(gl::GLsizei inWidth, gl::GLsizei inHeight, gl::GLenum inInternalFormat);
+	void Release(gl::GLuint inTexture);
+
+	// call once per render, deletes the free textures that have been idle for too long
+	void EndFrame(u_long inMaxIdleFrames = AESDK_OpenGL_TexturePoolIdleFrames);
+	void Clear();
+
+	u_long GetHits() const { return mHits; }
+	u_long GetMisses() const { return mMisses; }
+
+private:
+	struct PooledTexture
+	{
+		gl::GLuint	mTexture;
+		gl::GLsizei	mWidth;
+		gl::GLsizei	mHeight;
+		gl::GLenum	mInternalFormat;
+		u_long		mLastUsedFrame;
+	};
+
+	std::vector<PooledTexture> mFree;
+	std::vector<PooledTexture> mInUse;
+	u_long mFrame;
+	u_long mHits;
+	u_long mMisses;
+
+	AESDK_OpenGL_TexturePool(const AESDK_OpenGL_TexturePool &);
+	AESDK_OpenGL_TexturePool &operator=(const AESDK_OpenGL_TexturePool &);
+};
+
+// gives a pool texture back when leaving the scope, including when a render throws
+class ScopedPoolTexture
+{
+public:
+	ScopedPoolTexture(AESDK_OpenGL_TexturePool& inPool, gl::GLuint inTexture) : mPool(inPool), mTexture(inTexture) {}
+	~ScopedPoolTexture() { mPool.Release(mTexture); }
+
+	operator gl::GLuint() const { return mTexture; }
+
+private:
+	AESDK_OpenGL_TexturePool& mPool;
+	gl::GLuint mTexture;
+
+	ScopedPoolTexture(const ScopedPoolTexture &);
+	ScopedPoolTexture &operator=(const ScopedPoolTexture &);
+};
+
+/*
+// Per render context ring of pixel unpack buffers, the streaming alternative to uploading from client memory
+// - the CPU copy into one buffer overlaps the GPU transfer still reading the previous one
+// - a fence per buffer guards its reuse, so mapping never has to synchronize with the driver
+*/
+
+const u_long AESDK_OpenGL_UploadRingSize = 2;
+
+class AESDK_OpenGL_UploadRing
+{
+public:
+	AESDK_OpenGL_UploadRing();
+	~AESDK_OpenGL_UploadRing(); // the owning context must be current
+
+	// copies inHeight rows of inWidth pixels, inRowBytes apart at inSrcP, into the next buffer and re-specifies inTexture from it
+	void Upload(gl::GLuint inTexture, gl::GLsizei inWidth, gl::GLsizei inHeight, gl::GLenum inType,
+				size_t inPixelSize, const void* inSrcP, size_t inRowBytes);
+	void Clear();
+
+	u_long GetWaits() const { return mWaits; }
+
+private:
+	struct Slot
+	{
+		gl::GLuint	mBuffer;
+		size_t		mSize;
+		gl::GLsync	mFence;
+	};
+
+	Slot mSlots[AESDK_OpenGL_UploadRingSize];
+	u_long mNext;
+	u_long mWaits;	// uploads that found their buffer still in use by the GPU
+
+	AESDK_OpenGL_UploadRing(const AESDK_OpenGL_UploadRing &);
+	AESDK_OpenGL_UploadRing &operator=(const AESDK_OpenGL_UploadRing &);
+};
+
+/*
+// Per render context pixel pack buffers for reading the render back in strips
+// - strip i is copied to the destination while the GPU still transfers the strips after it
+// - each strip is fenced, so the CPU only ever waits for the rows it is about to copy
+*/
+
+const u_long AESDK_OpenGL_ReadbackRingSize = 2;
+const gl::GLsizei AESDK_OpenGL_ReadbackStripRows = 128;
+
+class AESDK_OpenGL_ReadbackRing
+{
+public:
+	AESDK_OpenGL_ReadbackRing();
+	~AESDK_OpenGL_ReadbackRing(); // the owning context must be current
+
+	// reads the bound read buffer into inHeight rows of inWidth pixels, inRowBytes apart at outDstP
+	void Read(gl::GLsizei inWidth, gl::GLsizei inHeight, gl::GLenum inType,
+			  size_t inPixelSize, void* outDstP, size_t inRowBytes);
+	void Clear();
+
+private:
+	struct Slot
+	{
+		gl::GLuint	mBuffer;
+		size_t		mSize;
+		gl::GLsync	mFence;
+	};
+
+	Slot mSlots[AESDK_OpenGL_ReadbackRingSize];
+
+	AESDK_OpenGL_ReadbackRing(const AESDK_OpenGL_ReadbackRing &);
+	AESDK_OpenGL_ReadbackRing &operator=(const AESDK_OpenGL_ReadbackRing &);
+};
+
+/*
+// Fixed set of threads that render on behalf of the host's threads
+// - a worker creates its render context on its first job and keeps it, so GPU memory scales
+//   with the pool and not with the number of threads the host renders from
+// - jobs run in submission order on whichever worker is free
+*/
+
+class AESDK_OpenGL_WorkerPool
+{
+public:
+	AESDK_OpenGL_WorkerPool();
+	~AESDK_OpenGL_WorkerPool();
+
+	void Start(size_t inWorkers);
+	// runs the jobs already queued, then joins the workers
+	void Stop();
+	bool IsRunning() const { return !mWorkers.empty(); }
+
+	// the future rethrows what the job threw, the job runs on the caller's thread when the pool isn't running
+	std::future<void> Submit(const std::function<void()>& inJob);
+
+private:
+	void WorkerLoop();
+
+	std::mutex mMutex;
+	std::condition_variable mJobAvailable;
+	std::deque<std::packaged_task<void()> > mJobs;
+	std::vector<std::thread> mWorkers;
+	bool mStopping;
+
+	AESDK_OpenGL_WorkerPool(const AESDK_OpenGL_WorkerPool &);
+	AESDK_OpenGL_WorkerPool &operator=(const AESDK_OpenGL_WorkerPool &);
+};
+
 /*
 // Per render/thread supporting OpenGL variables
 */
@@ -120,13 +368,26 @@ struct AESDK_OpenGL_EffectRenderData : public AESDK_OpenGL_EffectCommonData
 	gl::GLuint mFrameBufferSu;
 	gl::GLuint mColorRenderBufferSu;
 
-	u_int16 mRenderBufferWidthSu;
-	u_int16 mRenderBufferHeightSu;
+	// size of one tile, frames larger than that are rendered in several passes
+	gl::GLsizei mRenderBufferWidthSu;
+	gl::GLsizei mRenderBufferHeightSu;
+
+	AESDK_OpenGL_ProgramPtr mProgramObjRef;		// current noise permutation
 
-	gl::GLuint mProgramObjSu;
-	gl::GLuint mProgramObj2Su;
+	gl::GLuint mOutputFrameTexture; //pbo texture, from mTexturePool
+	gl::GLenum mOutputFrameFormat;	//internal format of mOutputFrameTexture
 
-	gl::GLuint mOutputFrameTexture; //pbo texture
+	AESDK_OpenGL_TexturePool mTexturePool;
+	AESDK_OpenGL_UploadRing mUploadRing;
+	AESDK_OpenGL_ReadbackRing mReadbackRing;
+
+	gl::GLuint mParamBuffer;		// uniform buffer behind the "NoiseParams" block
+	uint64_t mParamBlockHash;		// hash of the last upload
+	size_t mParamBlockSize;
+
+	gl::GLuint mRenderBuffer;		// uniform buffer behind the "RenderParams" block
+	uint64_t mRenderBlockHash;		// hash of the last upload
+	size_t mRenderBlockSize;
 
 	gl::GLuint vao;
 	gl::GLuint quad;
@@ -134,6 +395,93 @@ struct AESDK_OpenGL_EffectRenderData : public AESDK_OpenGL_EffectCommonData
 
 typedef std::shared_ptr<AESDK_OpenGL_EffectRenderData> AESDK_OpenGL_EffectRenderDataPtr;
 
+/*
+// Bounded set of render contexts, leased to the threads that render
+// - a thread gets back the context it used last, unless another thread took it over meanwhile:
+//   that lease only takes a compare and swap on the context's slot, cached per thread, no lock
+// - everything else goes through the pool's lock: contexts left by threads that exited go to new
+//   threads before any context is created, at capacity a new thread takes over the least recently
+//   used idle context, or waits for one
+// - contexts idle for AESDK_OpenGL_RenderContextIdleSeconds are deleted, GL objects and all
+*/
+
+const double AESDK_OpenGL_RenderContextIdleSeconds = 60.0;
+// idle contexts are looked for every that many lock-free leases of a thread, when the lock is free
+const u_long AESDK_OpenGL_RenderContextSweepLeases = 64;
+
+class AESDK_OpenGL_RenderContextPool
+{
+public:
+	explicit AESDK_OpenGL_RenderContextPool(size_t inCapacity);
+	~AESDK_OpenGL_RenderContextPool();
+
+	// 0 for no limit
+	void SetCapacity(size_t inCapacity);
+
+	// - the calling thread's context, exclusively until the same thread calls Release
+	// - evicted contexts are deleted on the calling thread, which must restore its own context afterwards
+	AESDK_OpenGL_EffectRenderDataPtr Acquire();
+	void Release(const AESDK_OpenGL_EffectRenderDataPtr& inContext);
+	// deletes every context, waiting for the leased ones to be released
+	void Clear();
+
+	u_long GetLiveCount() const;
+	u_long GetCreatedCount() const;
+	u_long GetEvictedCount() const;
+
+private:
+	struct Slot;
+	typedef std::shared_ptr<Slot> SlotPtr;
+
+	// - the slot a thread leased last, the reference keeps the slot (not its context) alive
+	//   however long the thread keeps it, so a stale cache only ever sees an evicted slot
+	// - the token dies with the thread
+	struct ThreadCache
+	{
+		std::shared_ptr<void>					mToken;
+		SlotPtr									mSlot;
+		const AESDK_OpenGL_RenderContextPool*	mPool;
+		u_long									mLeases;
+	};
+	static ThreadCache& GetThreadCache();
+
+	AESDK_OpenGL_EffectRenderDataPtr AcquireLocked(ThreadCache& ioCache);
+	// evicts the idle slots, mMutex must be held
+	void Sweep(std::vector<AESDK_OpenGL_EffectRenderDataPtr>& outEvicted);
+	void NotifyReleased();
+
+	mutable std::mutex mMutex;
+	std::condition_variable mReleased;
+	std::atomic<u_long> mWaiters;	// threads inside the lock that may wait for a release
+	size_t mCapacity;
+	std::vector<SlotPtr> mSlots;
+	u_long mCreated;
+	u_long mEvicted;
+
+	AESDK_OpenGL_RenderContextPool(const AESDK_OpenGL_RenderContextPool &);
+	AESDK_OpenGL_RenderContextPool &operator=(const AESDK_OpenGL_RenderContextPool &);
+};
+
+// gives the context back to its pool when leaving the scope, including when a render throws
+class AESDK_OpenGL_ScopedRenderContext
+{
+public:
+	explicit AESDK_OpenGL_ScopedRenderContext(AESDK_OpenGL_RenderContextPool& inPool) : mPool(inPool), mContext(inPool.Acquire()) {}
+	// the context is unbound first: once released, another thread may lease it or the pool may delete it
+	~AESDK_OpenGL_ScopedRenderContext() { mContext->ClearPluginContext(); mPool.Release(mContext); }
+
+	operator const AESDK_OpenGL_EffectRenderDataPtr&() const { return mContext; }
+	AESDK_OpenGL_EffectRenderData* operator->() const { return mContext.get(); }
+	AESDK_OpenGL_EffectRenderData& operator*() const { return *mContext; }
+
+private:
+	AESDK_OpenGL_RenderContextPool& mPool;
+	AESDK_OpenGL_EffectRenderDataPtr mContext;
+
+	AESDK_OpenGL_ScopedRenderContext(const AESDK_OpenGL_ScopedRenderContext &);
+	AESDK_OpenGL_ScopedRenderContext &operator=(const AESDK_OpenGL_ScopedRenderContext &);
+};
+
 enum AESDK_OpenGL_Err
 {
 	AESDK_OpenGL_OK = 0,
@@ -154,9 +502,14 @@ enum { PositionSlot, UVSlot };
 void AESDK_OpenGL_Startup(AESDK_OpenGL_EffectCommonData& inData, const AESDK_OpenGL_EffectCommonData* inRootContext = nullptr);
 void AESDK_OpenGL_Shutdown(AESDK_OpenGL_EffectCommonData& inData);
 
-void AESDK_OpenGL_InitResources(AESDK_OpenGL_EffectRenderData& inData, u_short inBufferWidth, u_short inBufferHeight, const std::string& resourcePath);
+void AESDK_OpenGL_InitResources(AESDK_OpenGL_EffectRenderData& inData, gl::GLsizei inBufferWidth, gl::GLsizei inBufferHeight, gl::GLenum inInternalFormat,
+								AESDK_OpenGL_ProgramCache& ioProgramCache, u_long inPermutationKey, const std::string& inPermutationDefines);
 void AESDK_OpenGL_MakeReadyToRender(AESDK_OpenGL_EffectRenderData& inData, gl::GLuint textureHandle);
-gl::GLuint AESDK_OpenGL_InitShader(std::string inVertexShaderFile, std::string inFragmentShaderFile);
+void AESDK_OpenGL_UpdateParamBlock(AESDK_OpenGL_EffectRenderData& inData, const void* inBlockP, size_t inBlockSize);
+void AESDK_OpenGL_UpdateRenderBlock(AESDK_OpenGL_EffectRenderData& inData, const void* inBlockP, size_t inBlockSize);
+gl::GLuint AESDK_OpenGL_InitShader(std::string inVertexShaderFile, std::string inFragmentShaderFile, const std::string& inDefines = std::string());
+gl::GLuint AESDK_OpenGL_InitShaderFromSource(const std::string& inVertexShaderSource, const std::string& inFragmentShaderSource,
+											 const std::string& inDefines = std::string(), bool inRetrievableB = false);
 void AESDK_OpenGL_BindTextureToTarget(gl::GLuint program, gl::GLint inTexture, std::string inTargetName);
 
 
@@ -177,6 +530,8 @@ std::string ReportError(AESDK_OpenGL_Err inError);
 std::string CheckFramebufferStatus();
 //helper function - read shader file into the compiler
 unsigned char* ReadShaderFile(std::string inFile);
+//helper function - embedded shader source by file name, unless the override folder has that file
+std::string AESDK_OpenGL_GetShaderSource(const std::string& inShaderName, const std::string& inOverridePath = std::string());
 
 /*
 //	Error class and macros used to trap errors
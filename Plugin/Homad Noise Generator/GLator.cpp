@@ -39,13 +39,17 @@
 #include "GLator.h"
 
 #include "GL_base.h"
+#include "GLator_Noise.h"
+#include "GLator_Kernels.h"
+#include "GLator_CPURender.h"
 #include "Smart_Utils.h"
 #include "AEFX_SuiteHelper.h"
 
+#include <algorithm>
 #include <thread>
 #include <atomic>
-#include <map>
 #include <mutex>
+#include <string.h>
 #include "vmath.hpp"
 #include <assert.h>
 
@@ -58,33 +62,90 @@ using namespace gl33core;
 /* AESDK_OpenGL effect specific variables */
 
 namespace {
-	THREAD_LOCAL int t_thread = -1;
-
-	std::atomic_int S_cnt;
-	std::map<int, std::shared_ptr<AESDK_OpenGL::AESDK_OpenGL_EffectRenderData> > S_render_contexts;
-	std::recursive_mutex S_mutex;
+	// - OpenGL resources are restricted per thread, mimicking the OGL driver: a render leases a context
+	//   for its thread from the pool
+	// - GLATOR_MAX_RENDER_CONTEXTS overrides the number of contexts alive at once at GlobalSetup, 0 for no limit
+	const A_long kDefaultMaxRenderContexts = 16;
+	AESDK_OpenGL::AESDK_OpenGL_RenderContextPool S_RenderContexts(kDefaultMaxRenderContexts);
 
 	AESDK_OpenGL::AESDK_OpenGL_EffectCommonDataPtr S_GLator_EffectCommonData; //global context
 	std::string S_ResourcePath;
 
-	// - OpenGL resources are restricted per thread, mimicking the OGL driver
-	// - The filter will eliminate all TLS (Thread Local Storage) at PF_Cmd_GLOBAL_SETDOWN
-	AESDK_OpenGL::AESDK_OpenGL_EffectRenderDataPtr GetCurrentRenderContext()
-	{
-		S_mutex.lock();
-		AESDK_OpenGL::AESDK_OpenGL_EffectRenderDataPtr result;
+	// - one noise program per distinct set of enabled layers, shared by all render contexts
+	// - most comps only toggle a handful of combinations, keep the most recent ones
+	const size_t kMaxNoisePermutations = 16;
+	AESDK_OpenGL::AESDK_OpenGL_ProgramCache S_NoisePrograms(kMaxNoisePermutations);
+
+	// - how UploadTexture hands the input world to the GPU, read once at GlobalSetup
+	// - GLATOR_UPLOAD_MODE=pbo streams through the context's unpack buffer ring, anything else uploads synchronously
+	enum UploadMode { UPLOAD_SYNC, UPLOAD_PBO };
+	UploadMode S_UploadMode = UPLOAD_SYNC;
+
+	// - how DownloadTexture gets the render into the output world, read once at GlobalSetup
+	// - GLATOR_READBACK_MODE=pbo reads in fenced strips through the context's pack buffers, anything else
+	//   reads straight into the output world
+	enum ReadbackMode { READBACK_DIRECT, READBACK_PBO };
+	ReadbackMode S_ReadbackMode = READBACK_DIRECT;
+
+	// - frames are rendered in tiles of at most that many pixels a side, which bounds the GPU memory
+	//   of a render thread whatever the frame size
+	// - GLATOR_TILE_SIZE overrides it at GlobalSetup, the GL texture size limit always applies
+	const A_long kDefaultRenderTileSize = 2048;
+	const A_long kMinRenderTileSize = 64;
+	A_long S_RenderTileSize = kDefaultRenderTileSize;
+
+	// - GLATOR_GL_WORKERS=n renders on n threads of the plug-in's own, each with one render context,
+	//   the host's render threads wait for them
+	// - unset or 0, every host thread renders with a context of its own
+	const A_long kMaxGLWorkers = 16;
+	AESDK_OpenGL::AESDK_OpenGL_WorkerPool S_GLWorkers;
+
+	// - GLATOR_RENDERER=cpu renders with the tiled CPU renderer instead of OpenGL, read once at GlobalSetup
+	// - its threads are shared by all frames, GLATOR_CPU_THREADS caps them (the render thread included)
+	bool S_RenderOnCPU = false;
+	GLatorCPU::TileWorkerPool S_CPUWorkers;
+
+	// - set for the rest of the process once OpenGL fails to start (no driver, headless node, VM):
+	//   every frame goes to the CPU renderer from then on, the GL probe is not retried
+	// - the backend that rendered is logged when it changes
+	enum RenderBackend { RENDER_BACKEND_NONE, RENDER_BACKEND_GL, RENDER_BACKEND_CPU };
+	std::atomic<bool> S_GLUnavailable(false);
+	std::atomic<int> S_LastRenderBackend(RENDER_BACKEND_NONE);
+
+	// fragment_shader.frag #defines, indexed by NOISE_LAYER_*
+	const char* const S_NoiseLayerDefines[NOISE_LAYER_NUM] = {
+		"THOR_GENERIC_1D_ON",
+		"THOR_GENERIC_2D_ON",
+		"THOR_GENERIC_3D_ON",
+		"THOR_PERLIN_2D_ON",
+		"THOR_PERLIN_3D_ON",
+		"THOR_PERLIN_4D_ON",
+		"THOR_SIMPLEX_2D_ON",
+		"THOR_SIMPLEX_3D_ON",
+		"THOR_SIMPLEX_4D_ON",
+		"THOR_VIQ_2D_ON",
+		"THOR_VORONOI_2D_ON",
+		"THOR_FRACTBROWN_1D_ON",
+		"THOR_FRACTBROWN_2D_ON",
+		"THOR_FRACTBROWN_3D_ON",
+		"THOR_FRACTBROWN_IQ_ON"
+	};
 
-		if (t_thread == -1) {
-			t_thread = S_cnt++;
+	// permutation key bit of the generator mode, above the layer bits
+	const A_long kGeneratorPermutationBit = 1L << NOISE_LAYER_NUM;
 
-			result.reset(new AESDK_OpenGL::AESDK_OpenGL_EffectRenderData());
-			S_render_contexts[t_thread] = result;
+	std::string GetNoisePermutationDefines(A_long enabledMask)
+	{
+		std::string defines;
+		if (enabledMask & kGeneratorPermutationBit) {
+			defines += "#define THOR_GENERATOR_ON\n";
 		}
-		else {
-			result = S_render_contexts[t_thread];
+		for (int layer = 0; layer < NOISE_LAYER_NUM; ++layer) {
+			if (enabledMask & (1L << layer)) {
+				defines += std::string("#define ") + S_NoiseLayerDefines[layer] + "\n";
+			}
 		}
-		S_mutex.unlock();
-		return result;
+		return defines;
 	}
 
 #ifdef AE_OS_WIN
@@ -141,140 +202,241 @@ namespace {
 		return resourcePath;
 	}
 
-	struct CopyPixelFloat_t {
-		PF_PixelFloat	*floatBufferP;
-		PF_EffectWorld	*input_worldP;
-	};
+	// empty when the variable is not set
+	std::string GetEnvironmentString(const char* nameP)
+	{
+		std::string result;
+#ifdef AE_OS_WIN
+		char* valueP = NULL;
+		size_t length = 0;
+		if (_dupenv_s(&valueP, &length, nameP) == 0 && valueP != NULL) {
+			result = valueP;
+			free(valueP);
+		}
+#else
+		const char* valueP = getenv(nameP);
+		if (valueP != NULL) {
+			result = valueP;
+		}
+#endif
+		return result;
+	}
 
-	PF_Err
-	CopyPixelFloatIn(
-		void			*refcon,
-		A_long			x,
-		A_long			y,
-		PF_PixelFloat	*inP,
-		PF_PixelFloat	*)
+	// one line to the debugger output on Windows, to the console on macOS, in release builds too
+	void LogMessage(const std::string& message)
 	{
-		CopyPixelFloat_t	*thiS = reinterpret_cast<CopyPixelFloat_t*>(refcon);
-		PF_PixelFloat		*outP = thiS->floatBufferP + y * thiS->input_worldP->width + x;
+		std::string line = "GLator: " + message + "\n";
+#ifdef AE_OS_WIN
+		OutputDebugStringA(line.c_str());
+#else
+		fputs(line.c_str(), stderr);
+#endif
+	}
 
-		outP->red = inP->red;
-		outP->green = inP->green;
-		outP->blue = inP->blue;
-		outP->alpha = inP->alpha;
+	void LogRenderBackend(RenderBackend backend)
+	{
+		if (S_LastRenderBackend.exchange(backend) == backend) {
+			return;
+		}
+		if (backend == RENDER_BACKEND_GL) {
+			LogMessage("rendering with OpenGL");
+		} else {
+			LogMessage(std::string("rendering on the CPU, ") +
+				GLatorKernels::GetCpuIsaName(GLatorKernels::GetCpuKernels().isa) + " kernels");
+		}
+	}
 
-		return PF_Err_NONE;
+	// the first failure is logged, later frames don't get this far
+	void SetGLUnavailable(const char* reasonP)
+	{
+		if (!S_GLUnavailable.exchange(true)) {
+			LogMessage(std::string("OpenGL unavailable (") + reasonP + "), falling back to the CPU renderer");
+		}
 	}
 
-	PF_Err
-	CopyPixelFloatOut(
-		void			*refcon,
-		A_long			x,
-		A_long			y,
-		PF_PixelFloat	*,
-		PF_PixelFloat	*outP)
+	// - development only: GLATOR_SHADER_DIR points at a GLSL_files folder whose
+	//   files take precedence over the shaders compiled into the plug-in
+	std::string GetShaderOverridePath()
 	{
-		CopyPixelFloat_t		*thiS = reinterpret_cast<CopyPixelFloat_t*>(refcon);
-		const PF_PixelFloat		*inP = thiS->floatBufferP + y * thiS->input_worldP->width + x;
+		std::string overridePath = GetEnvironmentString("GLATOR_SHADER_DIR");
+		if (!overridePath.empty() && overridePath[overridePath.size() - 1] != '/' && overridePath[overridePath.size() - 1] != '\\') {
+			overridePath += "/";
+		}
+		return overridePath;
+	}
 
-		outP->red = inP->red;
-		outP->green = inP->green;
-		outP->blue = inP->blue;
-		outP->alpha = inP->alpha;
+	UploadMode GetUploadMode()
+	{
+		return GetEnvironmentString("GLATOR_UPLOAD_MODE") == "pbo" ? UPLOAD_PBO : UPLOAD_SYNC;
+	}
 
-		return PF_Err_NONE;
+	ReadbackMode GetReadbackMode()
+	{
+		return GetEnvironmentString("GLATOR_READBACK_MODE") == "pbo" ? READBACK_PBO : READBACK_DIRECT;
 	}
 
+	A_long GetMaxRenderContexts()
+	{
+		std::string value = GetEnvironmentString("GLATOR_MAX_RENDER_CONTEXTS");
+		if (value.empty()) {
+			return kDefaultMaxRenderContexts;
+		}
+		return std::max(static_cast<A_long>(atol(value.c_str())), static_cast<A_long>(0));
+	}
 
-	gl::GLuint UploadTexture(AEGP_SuiteHandler& suites,					// >>
-							 PF_PixelFormat			format,				// >>
-							 PF_EffectWorld			*input_worldP,		// >>
-							 PF_EffectWorld			*output_worldP,		// >>
-							 PF_InData				*in_data,			// >>
-							 size_t& pixSizeOut,						// <<
-							 gl::GLenum& glFmtOut,						// <<
-							 float& multiplier16bitOut)					// <<
+	A_long GetGLWorkerCount()
 	{
-		// - upload to texture memory
-		// - we will convert on-the-fly from ARGB to RGBA, and also to pre-multiplied alpha,
-		// using a fragment shader
-#ifdef _DEBUG
-		GLint nUnpackAlignment;
-		::glGetIntegerv(GL_UNPACK_ALIGNMENT, &nUnpackAlignment);
-		assert(nUnpackAlignment == 4);
-#endif
+		A_long workers = atol(GetEnvironmentString("GLATOR_GL_WORKERS").c_str());
+		return std::min(std::max(workers, static_cast<A_long>(0)), kMaxGLWorkers);
+	}
 
-		gl::GLuint inputFrameTexture;
-		glGenTextures(1, &inputFrameTexture);
-		glBindTexture(GL_TEXTURE_2D, inputFrameTexture);
+	// - benchmarks and tests: GLATOR_CPU_ISA (scalar, sse42, avx2, avx512) caps the
+	//   instruction set of the CPU kernels, by default the best one the CPU runs
+	GLatorKernels::CpuIsa GetMaxCpuIsa()
+	{
+		std::string value = GetEnvironmentString("GLATOR_CPU_ISA");
+		for (int isa = 0; isa < GLatorKernels::CPU_ISA_NUM; ++isa) {
+			if (value == GLatorKernels::GetCpuIsaName(static_cast<GLatorKernels::CpuIsa>(isa))) {
+				return static_cast<GLatorKernels::CpuIsa>(isa);
+			}
+		}
+		return GLatorKernels::CPU_ISA_AVX512;
+	}
 
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, (GLint)GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, (GLint)GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, (GLint)GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, (GLint)GL_CLAMP_TO_EDGE);
+	bool GetRenderOnCPU()
+	{
+		return GetEnvironmentString("GLATOR_RENDERER") == "cpu";
+	}
 
-		glTexImage2D(GL_TEXTURE_2D, 0, (GLint)GL_RGBA32F, input_worldP->width, input_worldP->height, 0, GL_RGBA, GL_FLOAT, nullptr);
+	// pool threads, on top of the host's render thread: one per logical core by default
+	A_long GetCPUWorkerCount()
+	{
+		A_long threads = atol(GetEnvironmentString("GLATOR_CPU_THREADS").c_str());
+		if (threads <= 0) {
+			threads = static_cast<A_long>(std::thread::hardware_concurrency());
+		}
+		return std::max(threads - 1, static_cast<A_long>(0));
+	}
 
-		multiplier16bitOut = 1.0f;
+	A_long GetRenderTileSize()
+	{
+		A_long tileSize = atol(GetEnvironmentString("GLATOR_TILE_SIZE").c_str());
+		if (tileSize <= 0) {
+			return kDefaultRenderTileSize;
+		}
+		return std::max(tileSize, kMinRenderTileSize);
+	}
+
+	// - the smallest texture format that holds an AE world of that depth without loss
+	// - 16bpc is 0..32768, which a 16 bit normalized format stores exactly (half float would not)
+	gl::GLenum GetInternalFormat(PF_PixelFormat format)
+	{
 		switch (format)
 		{
 		case PF_PixelFormat_ARGB128:
+			return GL_RGBA32F;
+		case PF_PixelFormat_ARGB64:
+			return GL_RGBA16;
+		case PF_PixelFormat_ARGB32:
+			return GL_RGBA8;
+		default:
+			CHECK(PF_Err_BAD_CALLBACK_PARAM);
+			break;
+		}
+		return GL_RGBA32F;
+	}
+
+	// GL transfer type and pixel size of an AE world, and the scale from its range to the texture's
+	void GetTransferFormat(PF_PixelFormat		format,				// >>
+						   size_t&				pixSizeOut,			// <<
+						   gl::GLenum&			glFmtOut,			// <<
+						   float&				multiplier16bitOut)	// <<
+	{
+		multiplier16bitOut = 1.0f;
+		switch (format)
 		{
+		case PF_PixelFormat_ARGB128:
 			glFmtOut = GL_FLOAT;
 			pixSizeOut = sizeof(PF_PixelFloat);
-
-			std::auto_ptr<PF_PixelFloat> bufferFloat(new PF_PixelFloat[input_worldP->width * input_worldP->height]);
-			CopyPixelFloat_t refcon = { bufferFloat.get(), input_worldP };
-
-			CHECK(suites.IterateFloatSuite1()->iterate(in_data,
-				0,
-				input_worldP->height,
-				input_worldP,
-				nullptr,
-				reinterpret_cast<void*>(&refcon),
-				CopyPixelFloatIn,
-				output_worldP));
-
-			glPixelStorei(GL_UNPACK_ROW_LENGTH, input_worldP->width);
-			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, input_worldP->width, input_worldP->height, GL_RGBA, GL_FLOAT, bufferFloat.get());
 			break;
-		}
-
 		case PF_PixelFormat_ARGB64:
-		{
 			glFmtOut = GL_UNSIGNED_SHORT;
 			pixSizeOut = sizeof(PF_Pixel16);
 			multiplier16bitOut = 65535.0f / 32768.0f;
-
-			glPixelStorei(GL_UNPACK_ROW_LENGTH, input_worldP->rowbytes / sizeof(PF_Pixel16));
-			PF_Pixel16 *pixelDataStart = NULL;
-			PF_GET_PIXEL_DATA16(input_worldP, NULL, &pixelDataStart);
-			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, input_worldP->width, input_worldP->height, GL_RGBA, GL_UNSIGNED_SHORT, pixelDataStart);
 			break;
-		}
-
 		case PF_PixelFormat_ARGB32:
-		{
 			glFmtOut = GL_UNSIGNED_BYTE;
 			pixSizeOut = sizeof(PF_Pixel8);
-
-			glPixelStorei(GL_UNPACK_ROW_LENGTH, input_worldP->rowbytes / sizeof(PF_Pixel8));
-			PF_Pixel8 *pixelDataStart = NULL;
-			PF_GET_PIXEL_DATA8(input_worldP, NULL, &pixelDataStart);
-			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, input_worldP->width, input_worldP->height, GL_RGBA, GL_UNSIGNED_BYTE, pixelDataStart);
 			break;
-		}
-
 		default:
 			CHECK(PF_Err_BAD_CALLBACK_PARAM);
 			break;
 		}
+	}
+
+	// clips dst to src, an empty result is all zeroes
+	void IntersectLRect(const PF_LRect *src, PF_LRect *dst)
+	{
+		dst->left = mmax(dst->left, src->left);
+		dst->top = mmax(dst->top, src->top);
+		dst->right = mmin(dst->right, src->right);
+		dst->bottom = mmin(dst->bottom, src->bottom);
+		if (IsEmptyRect(dst)) {
+			AEFX_CLR_STRUCT(*dst);
+		}
+	}
+
+	void OffsetLRect(PF_LRect& rect, A_long dx, A_long dy)
+	{
+		rect.left += dx;
+		rect.right += dx;
+		rect.top += dy;
+		rect.bottom += dy;
+	}
+
+	void DeleteRenderRects(void *pre_render_data)
+	{
+		delete reinterpret_cast<RenderRects*>(pre_render_data);
+	}
+
+	// address of the top left pixel of a rect of the world, rows keep the world's rowbytes
+	char* GetRectPixels(PF_EffectWorld *worldP, const PF_LRect& rect, size_t pixSize)
+	{
+		return reinterpret_cast<char*>(worldP->data) + rect.top * worldP->rowbytes + rect.left * pixSize;
+	}
 
-		glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+	void UploadTexture(const AESDK_OpenGL::AESDK_OpenGL_EffectRenderDataPtr& renderContext,	// >>
+					   gl::GLuint				inputFrameTexture,	// <<
+					   PF_EffectWorld			*input_worldP,		// >>
+					   const PF_LRect&			tileRect,			// >>
+					   size_t					pixSize,			// >>
+					   gl::GLenum				glFmt)				// >>
+	{
+		// - upload the tile to the bottom left of the texture, the world is handed to GL in place
+		// - the noise shader converts on-the-fly from ARGB to RGBA, and back
+#ifdef _DEBUG
+		GLint nUnpackAlignment;
+		::glGetIntegerv(GL_UNPACK_ALIGNMENT, &nUnpackAlignment);
+		assert(nUnpackAlignment == 4);
+#endif
+		const char *tilePixelsP = GetRectPixels(input_worldP, tileRect, pixSize);
+		gl::GLsizei tileWidth = tileRect.right - tileRect.left;
+		gl::GLsizei tileHeight = tileRect.bottom - tileRect.top;
+
+		if (S_UploadMode == UPLOAD_PBO) {
+			// rows and all, into the next buffer of the ring
+			renderContext->mUploadRing.Upload(inputFrameTexture, tileWidth, tileHeight, glFmt,
+				pixSize, tilePixelsP, input_worldP->rowbytes);
+		} else {
+			// the row length skips the rest of the frame, and the padding at the end of each row
+			glBindTexture(GL_TEXTURE_2D, inputFrameTexture);
+			glPixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<GLint>(input_worldP->rowbytes / pixSize));
+			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, tileWidth, tileHeight, GL_RGBA, glFmt, tilePixelsP);
+			glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+		}
 
 		//unbind all textures
 		glBindTexture(GL_TEXTURE_2D, 0);
-
-		return inputFrameTexture;
 	}
 
 	void ReportIfErrorFramebuffer(PF_InData *in_data, PF_OutData *out_data)
@@ -290,67 +452,251 @@ namespace {
 	}
 
 
-	void SwizzleGL(const AESDK_OpenGL::AESDK_OpenGL_EffectRenderDataPtr& renderContext,
-				   A_long widthL, A_long heightL,
-				   gl::GLuint		inputFrameTexture,
-				   float			multiplier16bit)
+	// - fetch one THOR_* parameter into the noise stack, as its descriptor says, and check it back in
+	// - a layer toggle sets the layer's bit in enabled_mask
+	PF_Err CheckoutNoiseParam(PF_InData *in_data, A_long param, NoiseStackParams& noiseStack)
 	{
-		glBindTexture(GL_TEXTURE_2D, inputFrameTexture);
+		PF_Err		err = PF_Err_NONE,
+					err2 = PF_Err_NONE;
+		PF_ParamDef	paramDef;
+
+		AEFX_CLR_STRUCT(paramDef);
+		ERR(PF_CHECKOUT_PARAM(in_data,
+			param,
+			in_data->current_time,
+			in_data->time_step,
+			in_data->time_scale,
+			&paramDef));
+
+		if (!err) {
+			const ParamDescriptor& desc = kParamDescriptors[param];
+			NoiseLayerParams& layerParams = noiseStack.layers[desc.layer];
+			// the 0..100 sliders are scaled down to what the shader expects
+			float value = static_cast<float>(paramDef.u.fs_d.value / desc.divisor);
+
+			switch (desc.role)
+			{
+			case PARAM_ROLE_TOGGLE:
+				if (paramDef.u.bd.value) {
+					noiseStack.enabled_mask |= (1L << desc.layer);
+				}
+				break;
+			case PARAM_ROLE_VALUE:
+				layerParams.values[desc.slot] = value;
+				break;
+			case PARAM_ROLE_POS_MULT:
+				layerParams.pos_mult = value;
+				break;
+			case PARAM_ROLE_MIX:
+				layerParams.mix = value;
+				break;
+			case PARAM_ROLE_EXTRA:
+				layerParams.extra[desc.slot] = value;
+				break;
+			default:
+				break;
+			}
+		}
 
-		glUseProgram(renderContext->mProgramObj2Su);
+		ERR2(PF_CHECKIN_PARAM(in_data, &paramDef));
+		return err;
+	}
 
-		// view matrix, mimic windows coordinates
-		vmath::Matrix4 ModelviewProjection = vmath::Matrix4::translation(vmath::Vector3(-1.0f, -1.0f, 0.0f)) *
-			vmath::Matrix4::scale(vmath::Vector3(2.0 / float(widthL), 2.0 / float(heightL), 1.0f));
+	// - the layer toggles first, then only the parameters of the enabled layers
+	// - checkout cost scales with the active layers, disabled layers stay zeroed
+	// - mixOnly skips everything but the MIX of the enabled layers, enough for NoiseStackReadsInput
+	PF_Err CheckoutNoiseStack(PF_InData *in_data, NoiseStackParams& noiseStack, bool mixOnly = false)
+	{
+		PF_Err err = PF_Err_NONE;
 
-		GLint location = glGetUniformLocation(renderContext->mProgramObj2Su, "ModelviewProjection");
-		glUniformMatrix4fv(location, 1, GL_FALSE, (GLfloat*)&ModelviewProjection);
-		location = glGetUniformLocation(renderContext->mProgramObj2Su, "multiplier16bit");
-		glUniform1f(location, multiplier16bit);
+		AEFX_CLR_STRUCT(noiseStack);
 
-		AESDK_OpenGL_BindTextureToTarget(renderContext->mProgramObj2Su, inputFrameTexture, std::string("videoTexture"));
+		for (A_long param = 0; param < THOR_NUM_PARAMS && !err; ++param) {
+			if (kParamDescriptors[param].role == PARAM_ROLE_TOGGLE) {
+				ERR(CheckoutNoiseParam(in_data, param, noiseStack));
+			}
+		}
 
-		// render
-		glBindVertexArray(renderContext->vao);
-		RenderQuad(renderContext->quad);
-		glBindVertexArray(0);
+		for (A_long param = 0; param < THOR_NUM_PARAMS && !err; ++param) {
+			const ParamDescriptor& desc = kParamDescriptors[param];
+			if (desc.role != PARAM_ROLE_NONE && desc.role != PARAM_ROLE_TOGGLE &&
+				(noiseStack.enabled_mask & (1L << desc.layer)) &&
+				(!mixOnly || desc.role == PARAM_ROLE_MIX)) {
+				ERR(CheckoutNoiseParam(in_data, param, noiseStack));
+			}
+		}
+		return err;
+	}
 
-		glUseProgram(0);
+	// - each enabled layer keeps (1 - MIX) of what is under it, so the input survives with the product of those
+	// - one layer with a full MIX and the output no longer depends on the input
+	bool NoiseStackReadsInput(const NoiseStackParams& noiseStack)
+	{
+		for (int layer = 0; layer < NOISE_LAYER_NUM; ++layer) {
+			if ((noiseStack.enabled_mask & (1L << layer)) && noiseStack.layers[layer].mix >= 1.0f) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// no layer enabled, or only layers with a zero MIX: the output is the input
+	bool NoiseStackIsIdentity(const NoiseStackParams& noiseStack)
+	{
+		for (int layer = 0; layer < NOISE_LAYER_NUM; ++layer) {
+			if ((noiseStack.enabled_mask & (1L << layer)) && noiseStack.layers[layer].mix != 0.0f) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// - only the layers from the last one with a full MIX on are visible
+	// - with a zero POS_MULT a layer evaluates its noise at the same point for every pixel
+	bool NoiseStackIsConstant(const NoiseStackParams& noiseStack)
+	{
+		int firstVisibleLayer = 0;
+		for (int layer = 0; layer < NOISE_LAYER_NUM; ++layer) {
+			if ((noiseStack.enabled_mask & (1L << layer)) && noiseStack.layers[layer].mix >= 1.0f) {
+				firstVisibleLayer = layer;
+			}
+		}
+		for (int layer = firstVisibleLayer; layer < NOISE_LAYER_NUM; ++layer) {
+			const NoiseLayerParams& layerParams = noiseStack.layers[layer];
+			if ((noiseStack.enabled_mask & (1L << layer)) && layerParams.mix != 0.0f && layerParams.pos_mult != 0.0f) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// the output rect of the input world, row by row
+	void CopyInputToOutput(PF_EffectWorld			*input_worldP,		// >>
+						   const RenderRects&		rects,				// >>
+						   PF_EffectWorld			*output_worldP,		// <<
+						   PF_PixelFormat			format)				// >>
+	{
+		size_t pixSize;
+		gl::GLenum glFmt;
+		float multiplier16bit;
+		GetTransferFormat(format, pixSize, glFmt, multiplier16bit);
+
+		PF_LRect inputRect = { 0, 0, output_worldP->width, output_worldP->height };
+		OffsetLRect(inputRect, rects.output_rect.left - rects.input_rect.left, rects.output_rect.top - rects.input_rect.top);
+
+		const char *srcP = GetRectPixels(input_worldP, inputRect, pixSize);
+		char *dstP = reinterpret_cast<char*>(output_worldP->data);
+		size_t rowSize = output_worldP->width * pixSize;
+		for (A_long y = 0; y < output_worldP->height; ++y) {
+			memcpy(dstP + y * output_worldP->rowbytes, srcP + y * input_worldP->rowbytes, rowSize);
+		}
+	}
+
+	template <typename PixelType>
+	void FillWorld(PF_EffectWorld *worldP, const PixelType& pixel)
+	{
+		for (A_long y = 0; y < worldP->height; ++y) {
+			PixelType *rowP = reinterpret_cast<PixelType*>(reinterpret_cast<char*>(worldP->data) + y * worldP->rowbytes);
+			std::fill(rowP, rowP + worldP->width, pixel);
+		}
+	}
+
+	template <typename PixelType, typename ChannelType>
+	PixelType MakePixel(const float *rgbaP, float maxChannel)
+	{
+		// rounded like the GL normalized formats, straight alpha as the shader writes it
+		PixelType pixel;
+		pixel.alpha = static_cast<ChannelType>(rgbaP[3] * maxChannel + 0.5f);
+		pixel.red = static_cast<ChannelType>(rgbaP[0] * maxChannel + 0.5f);
+		pixel.green = static_cast<ChannelType>(rgbaP[1] * maxChannel + 0.5f);
+		pixel.blue = static_cast<ChannelType>(rgbaP[2] * maxChannel + 0.5f);
+		return pixel;
+	}
 
-		glFlush();
+	// - the colour of a constant generator, evaluated once on the CPU as the shader would for any pixel
+	// - the generator composites over transparent black, like THOR_GENERATOR_ON
+	void FillConstantOutput(const NoiseStackParams&	noiseStack,			// >>
+							PF_EffectWorld			*output_worldP,		// <<
+							PF_PixelFormat			format)				// >>
+	{
+		float rgba[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		GLatorNoise::EvaluateNoiseStack(noiseStack, 0.0f, 0.0f, rgba);
+		for (int c = 0; c < 4; ++c) {
+			rgba[c] = rgba[3] == 0.0f ? 0.0f : std::min(std::max(rgba[c], 0.0f), 1.0f);
+		}
+
+		switch (format)
+		{
+		case PF_PixelFormat_ARGB128:
+		{
+			PF_PixelFloat pixel;
+			pixel.alpha = rgba[3];
+			pixel.red = rgba[0];
+			pixel.green = rgba[1];
+			pixel.blue = rgba[2];
+			FillWorld(output_worldP, pixel);
+			break;
+		}
+		case PF_PixelFormat_ARGB64:
+			FillWorld(output_worldP, MakePixel<PF_Pixel16, A_u_short>(rgba, static_cast<float>(PF_MAX_CHAN16)));
+			break;
+		case PF_PixelFormat_ARGB32:
+			FillWorld(output_worldP, MakePixel<PF_Pixel8, A_u_char>(rgba, static_cast<float>(PF_MAX_CHAN8)));
+			break;
+		default:
+			CHECK(PF_Err_BAD_CALLBACK_PARAM);
+			break;
+		}
 	}
 
+	// - mirrors the std140 "RenderParams" block of the shaders
+	// - per render values live in the context's uniform buffer, the program is shared by all contexts
+	struct RenderBlock
+	{
+		float modelviewProjection[16];
+		float tileOffset[2];
+		float multiplier16bit;
+		float padding;
+	};
+
+	// tileRect is in layer coordinates, it is rendered to the bottom left of the target
 	void RenderGL(const AESDK_OpenGL::AESDK_OpenGL_EffectRenderDataPtr& renderContext,
-				  A_long widthL, A_long heightL,
+				  const PF_LRect&	tileRect,
 				  gl::GLuint		inputFrameTexture,
-				  PF_FpLong			sliderVal,
+				  const NoiseStackParams&	noiseStack,
 				  float				multiplier16bit)
 	{
-		// - make sure we blend correctly inside the framebuffer
-		// - even though we just cleared it, another effect may want to first
-		// draw some kind of background to blend with
-		glEnable(GL_BLEND);
-		glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
-		glBlendEquation(GL_FUNC_ADD);
+		// - the shader writes the final AE pixel, straight alpha and ARGB, no blending with the target
+		// - the quad covers the whole viewport, so the target doesn't need clearing first
+		A_long widthL = tileRect.right - tileRect.left;
+		A_long heightL = tileRect.bottom - tileRect.top;
 
 		// view matrix, mimic windows coordinates
+		// - the tile is rendered to the bottom left of the target, the quad may cover more than the viewport
 		vmath::Matrix4 ModelviewProjection = vmath::Matrix4::translation(vmath::Vector3(-1.0f, -1.0f, 0.0f)) *
 			vmath::Matrix4::scale(vmath::Vector3(2.0 / float(widthL), 2.0 / float(heightL), 1.0f));
 
-		glBindTexture(GL_TEXTURE_2D, inputFrameTexture);
+		glViewport(0, 0, widthL, heightL);
+
+		const AESDK_OpenGL::AESDK_OpenGL_ProgramPtr& program = renderContext->mProgramObjRef;
 
-		glUseProgram(renderContext->mProgramObjSu);
+		glUseProgram(program->mProgramSu);
 
-		// program uniforms
-		GLint location = glGetUniformLocation(renderContext->mProgramObjSu, "ModelviewProjection");
-		glUniformMatrix4fv(location, 1, GL_FALSE, (GLfloat*)&ModelviewProjection);
-		location = glGetUniformLocation(renderContext->mProgramObjSu, "sliderVal");
-		glUniform1f(location, sliderVal);
-		location = glGetUniformLocation(renderContext->mProgramObjSu, "multiplier16bit");
-		glUniform1f(location, multiplier16bit);
+		// tile placement and bit depth, never glUniform*: that would change them for every context drawing this program
+		RenderBlock renderBlock;
+		memcpy(renderBlock.modelviewProjection, &ModelviewProjection, sizeof(renderBlock.modelviewProjection));
+		renderBlock.tileOffset[0] = static_cast<float>(tileRect.left);
+		renderBlock.tileOffset[1] = static_cast<float>(tileRect.top);
+		renderBlock.multiplier16bit = multiplier16bit;
+		renderBlock.padding = 0.0f;
+		AESDK_OpenGL_UpdateRenderBlock(*renderContext.get(), &renderBlock, sizeof(renderBlock));
 
-		// Identify the texture to use and bind it to texture unit 0
-		AESDK_OpenGL_BindTextureToTarget(renderContext->mProgramObjSu, inputFrameTexture, std::string("videoTexture"));
+		// the noise layers live in the context's uniform buffer, only re-uploaded when they changed
+		AESDK_OpenGL_UpdateParamBlock(*renderContext.get(), noiseStack.layers, sizeof(noiseStack.layers));
+
+		// the sampler was pointed at this unit when the program was linked
+		glActiveTexture(GL_TEXTURE0 + AESDK_OpenGL_VideoTextureUnit);
+		glBindTexture(GL_TEXTURE_2D, inputFrameTexture);
 
 		// render
 		glBindVertexArray(renderContext->vao);
@@ -358,88 +704,32 @@ namespace {
 		glBindVertexArray(0);
 
 		glUseProgram(0);
-		glDisable(GL_BLEND);
 	}
 
 	void DownloadTexture(const AESDK_OpenGL::AESDK_OpenGL_EffectRenderDataPtr& renderContext,
-						 AEGP_SuiteHandler&		suites,				// >>
-						 PF_EffectWorld			*input_worldP,		// >>
-						 PF_EffectWorld			*output_worldP,		// >>
-						 PF_InData				*in_data,			// >>
-						 PF_PixelFormat			format,				// >>
+						 PF_EffectWorld			*output_worldP,		// <<
+						 const PF_LRect&		tileRect,			// >>
 						 size_t					pixSize,			// >>
 						 gl::GLenum				glFmt				// >>
 						 )
 	{
-		//download from texture memory onto the same surface
-		PF_Handle bufferH = NULL;
-		bufferH = suites.HandleSuite1()->host_new_handle(((renderContext->mRenderBufferWidthSu * renderContext->mRenderBufferHeightSu)* pixSize));
-		if (!bufferH) {
-			CHECK(PF_Err_OUT_OF_MEMORY);
-		}
-		void *bufferP = suites.HandleSuite1()->host_lock_handle(bufferH);
+		// - the render pass already wrote AE's pixel layout and range, rows only need to land at the right pitch
+		// - no intermediate buffer: the driver writes into the output world, or into the strips copied there
+		char *tilePixelsP = GetRectPixels(output_worldP, tileRect, pixSize);
+		gl::GLsizei tileWidth = tileRect.right - tileRect.left;
+		gl::GLsizei tileHeight = tileRect.bottom - tileRect.top;
 
 		glReadBuffer(GL_COLOR_ATTACHMENT0);
-		glReadPixels(0, 0, renderContext->mRenderBufferWidthSu, renderContext->mRenderBufferHeightSu, GL_RGBA, glFmt, bufferP);
-
-		switch (format)
-		{
-		case PF_PixelFormat_ARGB128:
-		{
-			PF_PixelFloat* bufferFloatP = reinterpret_cast<PF_PixelFloat*>(bufferP);
-			CopyPixelFloat_t refcon = { bufferFloatP, input_worldP };
-
-			CHECK(suites.IterateFloatSuite1()->iterate(in_data,
-				0,
-				input_worldP->height,
-				input_worldP,
-				nullptr,
-				reinterpret_cast<void*>(&refcon),
-				CopyPixelFloatOut,
-				output_worldP));
-			break;
-		}
-
-		case PF_PixelFormat_ARGB64:
-		{
-			PF_Pixel16* buffer16P = reinterpret_cast<PF_Pixel16*>(bufferP);
-
-			//copy to output_worldP
-			for (int y = 0; y < output_worldP->height; ++y)
-			{
-				PF_Pixel16 *pixelDataStart = NULL;
-				PF_GET_PIXEL_DATA16(output_worldP, NULL, &pixelDataStart);
-				::memcpy(pixelDataStart + (y * output_worldP->rowbytes / sizeof(PF_Pixel16)),
-					buffer16P + (y * renderContext->mRenderBufferWidthSu),
-					output_worldP->width * sizeof(PF_Pixel16));
-			}
-			break;
-		}
-
-		case PF_PixelFormat_ARGB32:
-		{
-			PF_Pixel8 *buffer8P = reinterpret_cast<PF_Pixel8*>(bufferP);
-
-			//copy to output_worldP
-			for (int y = 0; y < output_worldP->height; ++y)
-			{
-				PF_Pixel8 *pixelDataStart = NULL;
-				PF_GET_PIXEL_DATA8(output_worldP, NULL, &pixelDataStart);
-				::memcpy(pixelDataStart + (y * output_worldP->rowbytes / sizeof(PF_Pixel8)),
-					buffer8P + (y * renderContext->mRenderBufferWidthSu),
-					output_worldP->width * sizeof(PF_Pixel8));
-			}
-			break;
-		}
 
-		default:
-			CHECK(PF_Err_BAD_CALLBACK_PARAM);
-			break;
+		if (S_ReadbackMode == READBACK_PBO) {
+			renderContext->mReadbackRing.Read(tileWidth, tileHeight, glFmt,
+				pixSize, tilePixelsP, output_worldP->rowbytes);
+			return;
 		}
 
-		//clean the data after being copied
-		suites.HandleSuite1()->host_unlock_handle(bufferH);
-		suites.HandleSuite1()->host_dispose_handle(bufferH);
+		glPixelStorei(GL_PACK_ROW_LENGTH, static_cast<GLint>(output_worldP->rowbytes / pixSize));
+		glReadPixels(0, 0, tileWidth, tileHeight, GL_RGBA, glFmt, tilePixelsP);
+		glPixelStorei(GL_PACK_ROW_LENGTH, 0);
 	}
 } // anonymous namespace
 
@@ -486,11 +776,41 @@ GlobalSetup (
 		SaveRestoreOGLContext oSavedContext;
 		AEGP_SuiteHandler suites(in_data->pica_basicP);
 
+		// cpuid once, every CPU kernel goes through the selected set
+		GLatorKernels::SelectCpuKernels(GetMaxCpuIsa());
+
 		//Now comes the OpenGL part - OS specific loading to start with
+		// - without OpenGL the plug-in still loads, and renders on the CPU
 		S_GLator_EffectCommonData.reset(new AESDK_OpenGL::AESDK_OpenGL_EffectCommonData());
-		AESDK_OpenGL_Startup(*S_GLator_EffectCommonData.get());
-		
+		try
+		{
+			AESDK_OpenGL_Startup(*S_GLator_EffectCommonData.get());
+			S_GLator_EffectCommonData->mInitialized = true;
+		}
+		catch (...)
+		{
+			SetGLUnavailable("no context at startup");
+		}
+
 		S_ResourcePath = GetResourcesPath(in_data);
+
+		// linked programs are kept next to the plug-in, so that only the first render ever compiles
+		S_NoisePrograms.SetBinaryCachePath(S_ResourcePath);
+		S_NoisePrograms.SetShaderOverridePath(GetShaderOverridePath());
+
+		S_UploadMode = GetUploadMode();
+		S_ReadbackMode = GetReadbackMode();
+		S_RenderTileSize = GetRenderTileSize();
+
+		S_RenderContexts.SetCapacity(static_cast<size_t>(GetMaxRenderContexts()));
+
+		// the workers lease their render contexts from the pool like any render thread
+		if (!S_GLUnavailable) {
+			S_GLWorkers.Start(static_cast<size_t>(GetGLWorkerCount()));
+		}
+
+		S_RenderOnCPU = GetRenderOnCPU();
+		S_CPUWorkers.Start(static_cast<size_t>(GetCPUWorkerCount()));
 	}
 	catch(PF_Err& thrown_err)
 	{
@@ -1669,12 +1989,21 @@ GlobalSetdown (
 		// always restore back AE's own OGL context
 		SaveRestoreOGLContext oSavedContext;
 
-		S_mutex.lock();
-		S_render_contexts.clear();
-		S_mutex.unlock();
+		// the workers' contexts are released with the others below
+		S_GLWorkers.Stop();
+		S_CPUWorkers.Stop();
+
+		S_RenderContexts.Clear();
+
+		// - the render contexts released their permutations, delete the programs from the share group root
+		// - nothing to unload when the root context never started, see GlobalSetup
+		if (S_GLator_EffectCommonData && S_GLator_EffectCommonData->mInitialized) {
+			S_GLator_EffectCommonData->SetPluginContext();
+			S_NoisePrograms.Clear();
 
-		//OS specific unloading
-		AESDK_OpenGL_Shutdown(*S_GLator_EffectCommonData.get());
+			//OS specific unloading
+			AESDK_OpenGL_Shutdown(*S_GLator_EffectCommonData.get());
+		}
 		S_GLator_EffectCommonData.reset();
 		S_ResourcePath.clear();
 
@@ -1701,2324 +2030,246 @@ PreRender(
 	PF_OutData				*out_data,
 	PF_PreRenderExtra		*extra)
 {
-	PF_Err	err = PF_Err_NONE,
-			err2 = PF_Err_NONE;
-
-	PF_ParamDef		THOR_GENERIC_1D_START_Param;
-	PF_ParamDef		THOR_GENERIC_1D_VALUE_1_Param;
-	PF_ParamDef		THOR_GENERIC_1D_POS_MULT_Param;
-	PF_ParamDef		THOR_GENERIC_1D_MIX_Param;
-	PF_ParamDef		THOR_GENERIC_1D_END_Param;
-	PF_ParamDef		THOR_GENERIC_2D_START_Param;
-	PF_ParamDef		THOR_GENERIC_2D_VALUE_1_Param;
-	PF_ParamDef		THOR_GENERIC_2D_VALUE_2_Param;
-	PF_ParamDef		THOR_GENERIC_2D_POS_MULT_Param;
-	PF_ParamDef		THOR_GENERIC_2D_MIX_Param;
-	PF_ParamDef		THOR_GENERIC_2D_END_Param;
-	PF_ParamDef		THOR_GENERIC_3D_START_Param;
-	PF_ParamDef		THOR_GENERIC_3D_VALUE_1_Param;
-	PF_ParamDef		THOR_GENERIC_3D_VALUE_2_Param;
-	PF_ParamDef		THOR_GENERIC_3D_VALUE_3_Param;
-	PF_ParamDef		THOR_GENERIC_3D_POS_MULT_Param;
-	PF_ParamDef		THOR_GENERIC_3D_MIX_Param;
-	PF_ParamDef		THOR_GENERIC_3D_END_Param;
-	PF_ParamDef		THOR_PERLIN_2D_START_Param;
-	PF_ParamDef		THOR_PERLIN_2D_VALUE_1_Param;
-	PF_ParamDef		THOR_PERLIN_2D_VALUE_2_Param;
-	PF_ParamDef		THOR_PERLIN_2D_DIM_Param;
-	PF_ParamDef		THOR_PERLIN_2D_FREQ_Param;
-	PF_ParamDef		THOR_PERLIN_2D_POS_MULT_Param;
-	PF_ParamDef		THOR_PERLIN_2D_MIX_Param;
-	PF_ParamDef		THOR_PERLIN_2D_END_Param;
-	PF_ParamDef		THOR_PERLIN_3D_START_Param;
-	PF_ParamDef		THOR_PERLIN_3D_VALUE_1_Param;
-	PF_ParamDef		THOR_PERLIN_3D_VALUE_2_Param;
-	PF_ParamDef		THOR_PERLIN_3D_VALUE_3_Param;
-	PF_ParamDef		THOR_PERLIN_3D_POS_MULT_Param;
-	PF_ParamDef		THOR_PERLIN_3D_MIX_Param;
-	PF_ParamDef		THOR_PERLIN_3D_END_Param;
-	PF_ParamDef		THOR_PERLIN_4D_START_Param;
-	PF_ParamDef		THOR_PERLIN_4D_VALUE_1_Param;
-	PF_ParamDef		THOR_PERLIN_4D_VALUE_2_Param;
-	PF_ParamDef		THOR_PERLIN_4D_VALUE_3_Param;
-	PF_ParamDef		THOR_PERLIN_4D_VALUE_4_Param;
-	PF_ParamDef		THOR_PERLIN_4D_POS_MULT_Param;
-	PF_ParamDef		THOR_PERLIN_4D_MIX_Param;
-	PF_ParamDef		THOR_PERLIN_4D_END_Param;
-	PF_ParamDef		THOR_SIMPLEX_2D_START_Param;
-	PF_ParamDef		THOR_SIMPLEX_2D_VALUE_1_Param;
-	PF_ParamDef		THOR_SIMPLEX_2D_VALUE_2_Param;
-	PF_ParamDef		THOR_SIMPLEX_2D_POS_MULT_Param;
-	PF_ParamDef		THOR_SIMPLEX_2D_MIX_Param;
-	PF_ParamDef		THOR_SIMPLEX_2D_END_Param;
-	PF_ParamDef		THOR_SIMPLEX_3D_START_Param;
-	PF_ParamDef		THOR_SIMPLEX_3D_VALUE_1_Param;
-	PF_ParamDef		THOR_SIMPLEX_3D_VALUE_2_Param;
-	PF_ParamDef		THOR_SIMPLEX_3D_VALUE_3_Param;
-	PF_ParamDef		THOR_SIMPLEX_3D_POS_MULT_Param;
-	PF_ParamDef		THOR_SIMPLEX_3D_MIX_Param;
-	PF_ParamDef		THOR_SIMPLEX_3D_END_Param;
-	PF_ParamDef		THOR_SIMPLEX_4D_START_Param;
-	PF_ParamDef		THOR_SIMPLEX_4D_VALUE_1_Param;
-	PF_ParamDef		THOR_SIMPLEX_4D_VALUE_2_Param;
-	PF_ParamDef		THOR_SIMPLEX_4D_VALUE_3_Param;
-	PF_ParamDef		THOR_SIMPLEX_4D_VALUE_4_Param;
-	PF_ParamDef		THOR_SIMPLEX_4D_POS_MULT_Param;
-	PF_ParamDef		THOR_SIMPLEX_4D_MIX_Param;
-	PF_ParamDef		THOR_SIMPLEX_4D_END_Param;
-	PF_ParamDef		THOR_VIQ_2D_START_Param;
-	PF_ParamDef		THOR_VIQ_2D_VALUE_1_Param;
-	PF_ParamDef		THOR_VIQ_2D_VALUE_2_Param;
-	PF_ParamDef		THOR_VIQ_2D_U_Param;
-	PF_ParamDef		THOR_VIQ_2D_V_Param;
-	PF_ParamDef		THOR_VIQ_2D_POS_MULT_Param;
-	PF_ParamDef		THOR_VIQ_2D_MIX_Param;
-	PF_ParamDef		THOR_VIQ_2D_END_Param;
-	PF_ParamDef		THOR_VORONOI_2D_START_Param;
-	PF_ParamDef		THOR_VORONOI_2D_VALUE_1_Param;
-	PF_ParamDef		THOR_VORONOI_2D_VALUE_2_Param;
-	PF_ParamDef		THOR_VORONOI_2D_POS_MULT_Param;
-	PF_ParamDef		THOR_VORONOI_2D_MIX_Param;
-	PF_ParamDef		THOR_VORONOI_2D_END_Param;
-	PF_ParamDef		THOR_FRACTBROWN_1D_START_Param;
-	PF_ParamDef		THOR_FRACTBROWN_1D_VALUE_1_Param;
-	PF_ParamDef		THOR_FRACTBROWN_1D_POS_MULT_Param;
-	PF_ParamDef		THOR_FRACTBROWN_1D_MIX_Param;
-	PF_ParamDef		THOR_FRACTBROWN_1D_END_Param;
-	PF_ParamDef		THOR_FRACTBROWN_2D_START_Param;
-	PF_ParamDef		THOR_FRACTBROWN_2D_VALUE_1_Param;
-	PF_ParamDef		THOR_FRACTBROWN_2D_VALUE_2_Param;
-	PF_ParamDef		THOR_FRACTBROWN_2D_POS_MULT_Param;
-	PF_ParamDef		THOR_FRACTBROWN_2D_MIX_Param;
-	PF_ParamDef		THOR_FRACTBROWN_2D_END_Param;
-	PF_ParamDef		THOR_FRACTBROWN_3D_START_Param;
-	PF_ParamDef		THOR_FRACTBROWN_3D_VALUE_1_Param;
-	PF_ParamDef		THOR_FRACTBROWN_3D_VALUE_2_Param;
-	PF_ParamDef		THOR_FRACTBROWN_3D_VALUE_3_Param;
-	PF_ParamDef		THOR_FRACTBROWN_3D_POS_MULT_Param;
-	PF_ParamDef		THOR_FRACTBROWN_3D_MIX_Param;
-	PF_ParamDef		THOR_FRACTBROWN_3D_END_Param;
-	PF_ParamDef		THOR_FRACTBROWN_IQ_START_Param;
-	PF_ParamDef		THOR_FRACTBROWN_IQ_VALUE_1_Param;
-	PF_ParamDef		THOR_FRACTBROWN_IQ_VALUE_2_Param;
-	PF_ParamDef		THOR_FRACTBROWN_IQ_VALUE_3_Param;
-	PF_ParamDef		THOR_FRACTBROWN_IQ_VALUE_4_Param;
-	PF_ParamDef		THOR_FRACTBROWN_IQ_POS_MULT_Param;
-	PF_ParamDef		THOR_FRACTBROWN_IQ_MIX_Param;
-	PF_ParamDef		THOR_FRACTBROWN_IQ_END_Param;
-	PF_ParamDef		THOR_DISPLACE_START_Param;
-	PF_ParamDef		THOR_GENERIC_1D_CB_Param;
-	PF_ParamDef		THOR_GENERIC_2D_CB_Param;
-	PF_ParamDef		THOR_GENERIC_3D_CB_Param;
-	PF_ParamDef		THOR_PERLIN_2D_CB_Param;
-	PF_ParamDef		THOR_PERLIN_3D_CB_Param;
-	PF_ParamDef		THOR_PERLIN_4D_CB_Param;
-	PF_ParamDef		THOR_SIMPLEX_2D_CB_Param;
-	PF_ParamDef		THOR_SIMPLEX_3D_CB_Param;
-	PF_ParamDef		THOR_SIMPLEX_4D_CB_Param;
-	PF_ParamDef		THOR_VIQ_2D_CB_Param;
-	PF_ParamDef		THOR_VORONOI_2D_CB_Param;
-	PF_ParamDef		THOR_FACTBROWN_1D_CB_Param;
-	PF_ParamDef		THOR_FACTBROWN_2D_CB_Param;
-	PF_ParamDef		THOR_FACTBROWN_3D_CB_Param;
-	PF_ParamDef		THOR_FACTBROWN_4D_CB_Param;
-	PF_ParamDef		THOR_DISPLACE_END_Param;
+	PF_Err	err = PF_Err_NONE;
+
+	// - no parameter moves pixels (the noise is composited in place), so the output rect only
+	//   depends on the request and the input
+	// - whether the input shows through at all depends on the toggles and the MIX of the enabled
+	//   layers, nothing else is checked out here
+	NoiseStackParams noiseStack;
+	ERR(CheckoutNoiseStack(in_data, noiseStack, true));
+	bool generator = !err && !NoiseStackReadsInput(noiseStack);
 
 	PF_RenderRequest req = extra->input->output_request;
 	PF_CheckoutResult in_result;
 
+	// - a generator asks for an empty input rect, AE then skips rendering the upstream stack
+	// - the layer is still checked out for its bounds
+	if (generator) {
+		AEFX_CLR_STRUCT(req.rect);
+	}
 
-	AEFX_CLR_STRUCT(THOR_GENERIC_1D_START_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_1D_VALUE_1_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_1D_POS_MULT_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_1D_MIX_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_1D_END_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_2D_START_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_2D_VALUE_1_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_2D_VALUE_2_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_2D_POS_MULT_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_2D_MIX_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_2D_END_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_3D_START_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_3D_VALUE_1_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_3D_VALUE_2_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_3D_VALUE_3_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_3D_POS_MULT_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_3D_MIX_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_3D_END_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_2D_START_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_2D_VALUE_1_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_2D_VALUE_2_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_2D_DIM_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_2D_FREQ_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_2D_POS_MULT_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_2D_MIX_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_2D_END_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_3D_START_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_3D_VALUE_1_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_3D_VALUE_2_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_3D_VALUE_3_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_3D_POS_MULT_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_3D_MIX_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_3D_END_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_4D_START_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_4D_VALUE_1_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_4D_VALUE_2_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_4D_VALUE_3_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_4D_VALUE_4_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_4D_POS_MULT_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_4D_MIX_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_4D_END_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_2D_START_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_2D_VALUE_1_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_2D_VALUE_2_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_2D_POS_MULT_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_2D_MIX_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_2D_END_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_3D_START_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_3D_VALUE_1_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_3D_VALUE_2_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_3D_VALUE_3_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_3D_POS_MULT_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_3D_MIX_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_3D_END_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_4D_START_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_4D_VALUE_1_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_4D_VALUE_2_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_4D_VALUE_3_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_4D_VALUE_4_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_4D_POS_MULT_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_4D_MIX_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_4D_END_Param);
-	AEFX_CLR_STRUCT(THOR_VIQ_2D_START_Param);
-	AEFX_CLR_STRUCT(THOR_VIQ_2D_VALUE_1_Param);
-	AEFX_CLR_STRUCT(THOR_VIQ_2D_VALUE_2_Param);
-	AEFX_CLR_STRUCT(THOR_VIQ_2D_U_Param);
-	AEFX_CLR_STRUCT(THOR_VIQ_2D_V_Param);
-	AEFX_CLR_STRUCT(THOR_VIQ_2D_POS_MULT_Param);
-	AEFX_CLR_STRUCT(THOR_VIQ_2D_MIX_Param);
-	AEFX_CLR_STRUCT(THOR_VIQ_2D_END_Param);
-	AEFX_CLR_STRUCT(THOR_VORONOI_2D_START_Param);
-	AEFX_CLR_STRUCT(THOR_VORONOI_2D_VALUE_1_Param);
-	AEFX_CLR_STRUCT(THOR_VORONOI_2D_VALUE_2_Param);
-	AEFX_CLR_STRUCT(THOR_VORONOI_2D_POS_MULT_Param);
-	AEFX_CLR_STRUCT(THOR_VORONOI_2D_MIX_Param);
-	AEFX_CLR_STRUCT(THOR_VORONOI_2D_END_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_1D_START_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_1D_VALUE_1_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_1D_POS_MULT_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_1D_MIX_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_1D_END_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_2D_START_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_2D_VALUE_1_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_2D_VALUE_2_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_2D_POS_MULT_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_2D_MIX_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_2D_END_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_3D_START_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_3D_VALUE_1_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_3D_VALUE_2_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_3D_VALUE_3_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_3D_POS_MULT_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_3D_MIX_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_3D_END_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_IQ_START_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_IQ_VALUE_1_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_IQ_VALUE_2_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_IQ_VALUE_3_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_IQ_VALUE_4_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_IQ_POS_MULT_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_IQ_MIX_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_IQ_END_Param);
-	AEFX_CLR_STRUCT(THOR_DISPLACE_START_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_1D_CB_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_2D_CB_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_3D_CB_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_2D_CB_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_3D_CB_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_4D_CB_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_2D_CB_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_3D_CB_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_4D_CB_Param);
-	AEFX_CLR_STRUCT(THOR_VIQ_2D_CB_Param);
-	AEFX_CLR_STRUCT(THOR_VORONOI_2D_CB_Param);
-	AEFX_CLR_STRUCT(THOR_FACTBROWN_1D_CB_Param);
-	AEFX_CLR_STRUCT(THOR_FACTBROWN_2D_CB_Param);
-	AEFX_CLR_STRUCT(THOR_FACTBROWN_3D_CB_Param);
-	AEFX_CLR_STRUCT(THOR_FACTBROWN_4D_CB_Param);
-	AEFX_CLR_STRUCT(THOR_DISPLACE_END_Param);
-
-	
-	
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_1D_START,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_1D_START_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_1D_VALUE_1,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_1D_VALUE_1_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_1D_POS_MULT,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_1D_POS_MULT_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_1D_MIX,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_1D_MIX_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_1D_END,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_1D_END_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_2D_START,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_2D_START_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_2D_VALUE_1,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_2D_VALUE_1_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_2D_VALUE_2,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_2D_VALUE_2_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_2D_POS_MULT,
+	ERR(extra->cb->checkout_layer(in_data->effect_ref,
+		THOR_INPUT,
+		THOR_INPUT,
+		&req,
 		in_data->current_time,
 		in_data->time_step,
 		in_data->time_scale,
-		&THOR_GENERIC_2D_POS_MULT_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_2D_MIX,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_2D_MIX_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_2D_END,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_2D_END_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_3D_START,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_3D_START_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_3D_VALUE_1,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_3D_VALUE_1_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_3D_VALUE_2,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_3D_VALUE_2_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_3D_VALUE_3,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_3D_VALUE_3_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_3D_POS_MULT,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_3D_POS_MULT_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_3D_MIX,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_3D_MIX_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_3D_END,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_3D_END_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_2D_START,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_2D_START_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_2D_VALUE_1,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_2D_VALUE_1_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_2D_VALUE_2,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_2D_VALUE_2_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_2D_DIM,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_2D_DIM_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_2D_FREQ,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_2D_FREQ_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_2D_POS_MULT,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_2D_POS_MULT_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_2D_MIX,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_2D_MIX_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_2D_END,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_2D_END_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_3D_START,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_3D_START_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_3D_VALUE_1,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_3D_VALUE_1_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_3D_VALUE_2,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_3D_VALUE_2_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_3D_VALUE_3,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_3D_VALUE_3_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_3D_POS_MULT,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_3D_POS_MULT_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_3D_MIX,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_3D_MIX_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_3D_END,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_3D_END_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_4D_START,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_4D_START_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_4D_VALUE_1,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_4D_VALUE_1_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_4D_VALUE_2,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_4D_VALUE_2_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_4D_VALUE_3,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_4D_VALUE_3_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_4D_VALUE_4,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_4D_VALUE_4_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_4D_POS_MULT,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_4D_POS_MULT_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_4D_MIX,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_4D_MIX_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_4D_END,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_4D_END_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_2D_START,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_2D_START_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_2D_VALUE_1,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_2D_VALUE_1_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_2D_VALUE_2,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_2D_VALUE_2_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_2D_POS_MULT,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_2D_POS_MULT_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_2D_MIX,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_2D_MIX_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_2D_END,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_2D_END_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_3D_START,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_3D_START_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_3D_VALUE_1,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_3D_VALUE_1_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_3D_VALUE_2,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_3D_VALUE_2_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_3D_VALUE_3,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_3D_VALUE_3_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_3D_POS_MULT,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_3D_POS_MULT_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_3D_MIX,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_3D_MIX_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_3D_END,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_3D_END_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_4D_START,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_4D_START_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_4D_VALUE_1,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_4D_VALUE_1_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_4D_VALUE_2,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_4D_VALUE_2_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_4D_VALUE_3,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_4D_VALUE_3_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_4D_VALUE_4,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_4D_VALUE_4_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_4D_POS_MULT,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_4D_POS_MULT_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_4D_MIX,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_4D_MIX_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_4D_END,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_4D_END_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_VIQ_2D_START,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_VIQ_2D_START_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_VIQ_2D_VALUE_1,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_VIQ_2D_VALUE_1_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_VIQ_2D_VALUE_2,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_VIQ_2D_VALUE_2_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_VIQ_2D_U_MULT,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_VIQ_2D_U_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_VIQ_2D_V_MULT,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_VIQ_2D_V_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_VIQ_2D_POS_MULT,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_VIQ_2D_POS_MULT_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_VIQ_2D_MIX,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_VIQ_2D_MIX_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_VIQ_2D_END,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_VIQ_2D_END_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_VORONOI_2D_START,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_VORONOI_2D_START_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_VORONOI_2D_VALUE_1,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_VORONOI_2D_VALUE_1_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_VORONOI_2D_VALUE_2,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_VORONOI_2D_VALUE_2_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_VORONOI_2D_POS_MULT,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_VORONOI_2D_POS_MULT_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_VORONOI_2D_MIX,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_VORONOI_2D_MIX_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_VORONOI_2D_END,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_VORONOI_2D_END_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_1D_START,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_1D_START_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_1D_VALUE_1,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_1D_VALUE_1_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_1D_POS_MULT,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_1D_POS_MULT_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_1D_MIX,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_1D_MIX_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_1D_END,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_1D_END_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_2D_START,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_2D_START_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_2D_VALUE_1,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_2D_VALUE_1_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_2D_VALUE_2,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_2D_VALUE_2_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_2D_POS_MULT,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_2D_POS_MULT_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_2D_MIX,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_2D_MIX_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_2D_END,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_2D_END_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_3D_START,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_3D_START_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_3D_VALUE_1,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_3D_VALUE_1_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_3D_VALUE_2,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_3D_VALUE_2_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_3D_VALUE_3,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_3D_VALUE_3_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_3D_POS_MULT,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_3D_POS_MULT_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_3D_MIX,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_3D_MIX_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_3D_END,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_3D_END_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_IQ_START,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_IQ_START_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_IQ_VALUE_1,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_IQ_VALUE_1_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_IQ_VALUE_2,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_IQ_VALUE_2_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_IQ_VALUE_3,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_IQ_VALUE_3_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_IQ_VALUE_4,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_IQ_VALUE_4_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_IQ_POS_MULT,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_IQ_POS_MULT_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_IQ_MIX,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_IQ_MIX_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_IQ_END,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_IQ_END_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_DISPLACE_START,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_DISPLACE_START_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_1D_CB,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_1D_CB_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_2D_CB,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_2D_CB_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_3D_CB,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_3D_CB_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_2D_CB,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_2D_CB_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_3D_CB,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_3D_CB_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_4D_CB,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_4D_CB_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_2D_CB,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_2D_CB_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_3D_CB,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_3D_CB_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_4D_CB,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_4D_CB_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_VIQ_2D_CB,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_VIQ_2D_CB_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_VORONOI_2D_CB,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_VORONOI_2D_CB_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FACTBROWN_1D_CB,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FACTBROWN_1D_CB_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FACTBROWN_2D_CB,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FACTBROWN_2D_CB_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FACTBROWN_3D_CB,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FACTBROWN_3D_CB_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FACTBROWN_4D_CB,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FACTBROWN_4D_CB_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_DISPLACE_END,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_DISPLACE_END_Param));
-
-	ERR(extra->cb->checkout_layer(in_data->effect_ref,
-		THOR_INPUT,
-		THOR_INPUT,
-		&req,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&in_result));
-
-	if (!err){
-		UnionLRect(&in_result.result_rect, &extra->output->result_rect);
-		UnionLRect(&in_result.max_result_rect, &extra->output->max_result_rect);
-	}
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_1D_START_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_1D_VALUE_1_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_1D_POS_MULT_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_1D_MIX_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_1D_END_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_2D_START_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_2D_VALUE_1_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_2D_VALUE_2_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_2D_POS_MULT_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_2D_MIX_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_2D_END_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_3D_START_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_3D_VALUE_1_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_3D_VALUE_2_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_3D_VALUE_3_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_3D_POS_MULT_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_3D_MIX_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_3D_END_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_2D_START_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_2D_VALUE_1_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_2D_VALUE_2_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_2D_DIM_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_2D_FREQ_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_2D_POS_MULT_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_2D_MIX_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_2D_END_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_3D_START_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_3D_VALUE_1_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_3D_VALUE_2_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_3D_VALUE_3_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_3D_POS_MULT_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_3D_MIX_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_3D_END_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_4D_START_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_4D_VALUE_1_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_4D_VALUE_2_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_4D_VALUE_3_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_4D_VALUE_4_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_4D_POS_MULT_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_4D_MIX_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_4D_END_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_2D_START_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_2D_VALUE_1_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_2D_VALUE_2_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_2D_POS_MULT_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_2D_MIX_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_2D_END_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_3D_START_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_3D_VALUE_1_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_3D_VALUE_2_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_3D_VALUE_3_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_3D_POS_MULT_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_3D_MIX_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_3D_END_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_4D_START_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_4D_VALUE_1_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_4D_VALUE_2_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_4D_VALUE_3_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_4D_VALUE_4_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_4D_POS_MULT_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_4D_MIX_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_4D_END_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_VIQ_2D_START_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_VIQ_2D_VALUE_1_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_VIQ_2D_VALUE_2_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_VIQ_2D_U_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_VIQ_2D_V_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_VIQ_2D_POS_MULT_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_VIQ_2D_MIX_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_VIQ_2D_END_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_VORONOI_2D_START_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_VORONOI_2D_VALUE_1_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_VORONOI_2D_VALUE_2_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_VORONOI_2D_POS_MULT_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_VORONOI_2D_MIX_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_VORONOI_2D_END_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_1D_START_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_1D_VALUE_1_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_1D_POS_MULT_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_1D_MIX_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_1D_END_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_2D_START_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_2D_VALUE_1_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_2D_VALUE_2_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_2D_POS_MULT_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_2D_MIX_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_2D_END_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_3D_START_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_3D_VALUE_1_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_3D_VALUE_2_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_3D_VALUE_3_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_3D_POS_MULT_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_3D_MIX_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_3D_END_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_IQ_START_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_IQ_VALUE_1_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_IQ_VALUE_2_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_IQ_VALUE_3_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_IQ_VALUE_4_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_IQ_POS_MULT_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_IQ_MIX_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_IQ_END_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_DISPLACE_START_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_1D_CB_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_2D_CB_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_3D_CB_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_2D_CB_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_3D_CB_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_4D_CB_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_2D_CB_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_3D_CB_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_4D_CB_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_VIQ_2D_CB_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_VORONOI_2D_CB_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FACTBROWN_1D_CB_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FACTBROWN_2D_CB_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FACTBROWN_3D_CB_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FACTBROWN_4D_CB_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_DISPLACE_END_Param));
-	return err;
-}
-
-static PF_Err
-SmartRender(
-	PF_InData				*in_data,
-	PF_OutData				*out_data,
-	PF_SmartRenderExtra		*extra)
-{
-	PF_Err				err = PF_Err_NONE,
-						err2 = PF_Err_NONE;
-
-	PF_EffectWorld		*input_worldP = NULL,
-						*output_worldP = NULL;
-	PF_WorldSuite2		*wsP = NULL;
-	PF_PixelFormat		format = PF_PixelFormat_INVALID;
-	PF_FpLong			sliderVal = 0;
-
-	AEGP_SuiteHandler suites(in_data->pica_basicP);
-
-	PF_ParamDef		THOR_GENERIC_1D_START_Param;
-	PF_ParamDef		THOR_GENERIC_1D_VALUE_1_Param;
-	PF_ParamDef		THOR_GENERIC_1D_POS_MULT_Param;
-	PF_ParamDef		THOR_GENERIC_1D_MIX_Param;
-	PF_ParamDef		THOR_GENERIC_1D_END_Param;
-	PF_ParamDef		THOR_GENERIC_2D_START_Param;
-	PF_ParamDef		THOR_GENERIC_2D_VALUE_1_Param;
-	PF_ParamDef		THOR_GENERIC_2D_VALUE_2_Param;
-	PF_ParamDef		THOR_GENERIC_2D_POS_MULT_Param;
-	PF_ParamDef		THOR_GENERIC_2D_MIX_Param;
-	PF_ParamDef		THOR_GENERIC_2D_END_Param;
-	PF_ParamDef		THOR_GENERIC_3D_START_Param;
-	PF_ParamDef		THOR_GENERIC_3D_VALUE_1_Param;
-	PF_ParamDef		THOR_GENERIC_3D_VALUE_2_Param;
-	PF_ParamDef		THOR_GENERIC_3D_VALUE_3_Param;
-	PF_ParamDef		THOR_GENERIC_3D_POS_MULT_Param;
-	PF_ParamDef		THOR_GENERIC_3D_MIX_Param;
-	PF_ParamDef		THOR_GENERIC_3D_END_Param;
-	PF_ParamDef		THOR_PERLIN_2D_START_Param;
-	PF_ParamDef		THOR_PERLIN_2D_VALUE_1_Param;
-	PF_ParamDef		THOR_PERLIN_2D_VALUE_2_Param;
-	PF_ParamDef		THOR_PERLIN_2D_DIM_Param;
-	PF_ParamDef		THOR_PERLIN_2D_FREQ_Param;
-	PF_ParamDef		THOR_PERLIN_2D_POS_MULT_Param;
-	PF_ParamDef		THOR_PERLIN_2D_MIX_Param;
-	PF_ParamDef		THOR_PERLIN_2D_END_Param;
-	PF_ParamDef		THOR_PERLIN_3D_START_Param;
-	PF_ParamDef		THOR_PERLIN_3D_VALUE_1_Param;
-	PF_ParamDef		THOR_PERLIN_3D_VALUE_2_Param;
-	PF_ParamDef		THOR_PERLIN_3D_VALUE_3_Param;
-	PF_ParamDef		THOR_PERLIN_3D_POS_MULT_Param;
-	PF_ParamDef		THOR_PERLIN_3D_MIX_Param;
-	PF_ParamDef		THOR_PERLIN_3D_END_Param;
-	PF_ParamDef		THOR_PERLIN_4D_START_Param;
-	PF_ParamDef		THOR_PERLIN_4D_VALUE_1_Param;
-	PF_ParamDef		THOR_PERLIN_4D_VALUE_2_Param;
-	PF_ParamDef		THOR_PERLIN_4D_VALUE_3_Param;
-	PF_ParamDef		THOR_PERLIN_4D_VALUE_4_Param;
-	PF_ParamDef		THOR_PERLIN_4D_POS_MULT_Param;
-	PF_ParamDef		THOR_PERLIN_4D_MIX_Param;
-	PF_ParamDef		THOR_PERLIN_4D_END_Param;
-	PF_ParamDef		THOR_SIMPLEX_2D_START_Param;
-	PF_ParamDef		THOR_SIMPLEX_2D_VALUE_1_Param;
-	PF_ParamDef		THOR_SIMPLEX_2D_VALUE_2_Param;
-	PF_ParamDef		THOR_SIMPLEX_2D_POS_MULT_Param;
-	PF_ParamDef		THOR_SIMPLEX_2D_MIX_Param;
-	PF_ParamDef		THOR_SIMPLEX_2D_END_Param;
-	PF_ParamDef		THOR_SIMPLEX_3D_START_Param;
-	PF_ParamDef		THOR_SIMPLEX_3D_VALUE_1_Param;
-	PF_ParamDef		THOR_SIMPLEX_3D_VALUE_2_Param;
-	PF_ParamDef		THOR_SIMPLEX_3D_VALUE_3_Param;
-	PF_ParamDef		THOR_SIMPLEX_3D_POS_MULT_Param;
-	PF_ParamDef		THOR_SIMPLEX_3D_MIX_Param;
-	PF_ParamDef		THOR_SIMPLEX_3D_END_Param;
-	PF_ParamDef		THOR_SIMPLEX_4D_START_Param;
-	PF_ParamDef		THOR_SIMPLEX_4D_VALUE_1_Param;
-	PF_ParamDef		THOR_SIMPLEX_4D_VALUE_2_Param;
-	PF_ParamDef		THOR_SIMPLEX_4D_VALUE_3_Param;
-	PF_ParamDef		THOR_SIMPLEX_4D_VALUE_4_Param;
-	PF_ParamDef		THOR_SIMPLEX_4D_POS_MULT_Param;
-	PF_ParamDef		THOR_SIMPLEX_4D_MIX_Param;
-	PF_ParamDef		THOR_SIMPLEX_4D_END_Param;
-	PF_ParamDef		THOR_VIQ_2D_START_Param;
-	PF_ParamDef		THOR_VIQ_2D_VALUE_1_Param;
-	PF_ParamDef		THOR_VIQ_2D_VALUE_2_Param;
-	PF_ParamDef		THOR_VIQ_2D_U_Param;
-	PF_ParamDef		THOR_VIQ_2D_V_Param;
-	PF_ParamDef		THOR_VIQ_2D_POS_MULT_Param;
-	PF_ParamDef		THOR_VIQ_2D_MIX_Param;
-	PF_ParamDef		THOR_VIQ_2D_END_Param;
-	PF_ParamDef		THOR_VORONOI_2D_START_Param;
-	PF_ParamDef		THOR_VORONOI_2D_VALUE_1_Param;
-	PF_ParamDef		THOR_VORONOI_2D_VALUE_2_Param;
-	PF_ParamDef		THOR_VORONOI_2D_POS_MULT_Param;
-	PF_ParamDef		THOR_VORONOI_2D_MIX_Param;
-	PF_ParamDef		THOR_VORONOI_2D_END_Param;
-	PF_ParamDef		THOR_FRACTBROWN_1D_START_Param;
-	PF_ParamDef		THOR_FRACTBROWN_1D_VALUE_1_Param;
-	PF_ParamDef		THOR_FRACTBROWN_1D_POS_MULT_Param;
-	PF_ParamDef		THOR_FRACTBROWN_1D_MIX_Param;
-	PF_ParamDef		THOR_FRACTBROWN_1D_END_Param;
-	PF_ParamDef		THOR_FRACTBROWN_2D_START_Param;
-	PF_ParamDef		THOR_FRACTBROWN_2D_VALUE_1_Param;
-	PF_ParamDef		THOR_FRACTBROWN_2D_VALUE_2_Param;
-	PF_ParamDef		THOR_FRACTBROWN_2D_POS_MULT_Param;
-	PF_ParamDef		THOR_FRACTBROWN_2D_MIX_Param;
-	PF_ParamDef		THOR_FRACTBROWN_2D_END_Param;
-	PF_ParamDef		THOR_FRACTBROWN_3D_START_Param;
-	PF_ParamDef		THOR_FRACTBROWN_3D_VALUE_1_Param;
-	PF_ParamDef		THOR_FRACTBROWN_3D_VALUE_2_Param;
-	PF_ParamDef		THOR_FRACTBROWN_3D_VALUE_3_Param;
-	PF_ParamDef		THOR_FRACTBROWN_3D_POS_MULT_Param;
-	PF_ParamDef		THOR_FRACTBROWN_3D_MIX_Param;
-	PF_ParamDef		THOR_FRACTBROWN_3D_END_Param;
-	PF_ParamDef		THOR_FRACTBROWN_IQ_START_Param;
-	PF_ParamDef		THOR_FRACTBROWN_IQ_VALUE_1_Param;
-	PF_ParamDef		THOR_FRACTBROWN_IQ_VALUE_2_Param;
-	PF_ParamDef		THOR_FRACTBROWN_IQ_VALUE_3_Param;
-	PF_ParamDef		THOR_FRACTBROWN_IQ_VALUE_4_Param;
-	PF_ParamDef		THOR_FRACTBROWN_IQ_POS_MULT_Param;
-	PF_ParamDef		THOR_FRACTBROWN_IQ_MIX_Param;
-	PF_ParamDef		THOR_FRACTBROWN_IQ_END_Param;
-	PF_ParamDef		THOR_DISPLACE_START_Param;
-	PF_ParamDef		THOR_GENERIC_1D_CB_Param;
-	PF_ParamDef		THOR_GENERIC_2D_CB_Param;
-	PF_ParamDef		THOR_GENERIC_3D_CB_Param;
-	PF_ParamDef		THOR_PERLIN_2D_CB_Param;
-	PF_ParamDef		THOR_PERLIN_3D_CB_Param;
-	PF_ParamDef		THOR_PERLIN_4D_CB_Param;
-	PF_ParamDef		THOR_SIMPLEX_2D_CB_Param;
-	PF_ParamDef		THOR_SIMPLEX_3D_CB_Param;
-	PF_ParamDef		THOR_SIMPLEX_4D_CB_Param;
-	PF_ParamDef		THOR_VIQ_2D_CB_Param;
-	PF_ParamDef		THOR_VORONOI_2D_CB_Param;
-	PF_ParamDef		THOR_FACTBROWN_1D_CB_Param;
-	PF_ParamDef		THOR_FACTBROWN_2D_CB_Param;
-	PF_ParamDef		THOR_FACTBROWN_3D_CB_Param;
-	PF_ParamDef		THOR_FACTBROWN_4D_CB_Param;
-	PF_ParamDef		THOR_DISPLACE_END_Param;
-
-	AEFX_CLR_STRUCT(THOR_GENERIC_1D_START_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_1D_VALUE_1_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_1D_POS_MULT_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_1D_MIX_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_1D_END_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_2D_START_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_2D_VALUE_1_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_2D_VALUE_2_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_2D_POS_MULT_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_2D_MIX_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_2D_END_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_3D_START_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_3D_VALUE_1_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_3D_VALUE_2_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_3D_VALUE_3_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_3D_POS_MULT_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_3D_MIX_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_3D_END_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_2D_START_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_2D_VALUE_1_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_2D_VALUE_2_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_2D_DIM_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_2D_FREQ_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_2D_POS_MULT_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_2D_MIX_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_2D_END_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_3D_START_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_3D_VALUE_1_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_3D_VALUE_2_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_3D_VALUE_3_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_3D_POS_MULT_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_3D_MIX_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_3D_END_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_4D_START_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_4D_VALUE_1_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_4D_VALUE_2_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_4D_VALUE_3_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_4D_VALUE_4_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_4D_POS_MULT_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_4D_MIX_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_4D_END_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_2D_START_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_2D_VALUE_1_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_2D_VALUE_2_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_2D_POS_MULT_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_2D_MIX_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_2D_END_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_3D_START_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_3D_VALUE_1_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_3D_VALUE_2_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_3D_VALUE_3_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_3D_POS_MULT_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_3D_MIX_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_3D_END_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_4D_START_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_4D_VALUE_1_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_4D_VALUE_2_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_4D_VALUE_3_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_4D_VALUE_4_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_4D_POS_MULT_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_4D_MIX_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_4D_END_Param);
-	AEFX_CLR_STRUCT(THOR_VIQ_2D_START_Param);
-	AEFX_CLR_STRUCT(THOR_VIQ_2D_VALUE_1_Param);
-	AEFX_CLR_STRUCT(THOR_VIQ_2D_VALUE_2_Param);
-	AEFX_CLR_STRUCT(THOR_VIQ_2D_U_Param);
-	AEFX_CLR_STRUCT(THOR_VIQ_2D_V_Param);
-	AEFX_CLR_STRUCT(THOR_VIQ_2D_POS_MULT_Param);
-	AEFX_CLR_STRUCT(THOR_VIQ_2D_MIX_Param);
-	AEFX_CLR_STRUCT(THOR_VIQ_2D_END_Param);
-	AEFX_CLR_STRUCT(THOR_VORONOI_2D_START_Param);
-	AEFX_CLR_STRUCT(THOR_VORONOI_2D_VALUE_1_Param);
-	AEFX_CLR_STRUCT(THOR_VORONOI_2D_VALUE_2_Param);
-	AEFX_CLR_STRUCT(THOR_VORONOI_2D_POS_MULT_Param);
-	AEFX_CLR_STRUCT(THOR_VORONOI_2D_MIX_Param);
-	AEFX_CLR_STRUCT(THOR_VORONOI_2D_END_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_1D_START_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_1D_VALUE_1_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_1D_POS_MULT_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_1D_MIX_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_1D_END_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_2D_START_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_2D_VALUE_1_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_2D_VALUE_2_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_2D_POS_MULT_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_2D_MIX_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_2D_END_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_3D_START_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_3D_VALUE_1_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_3D_VALUE_2_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_3D_VALUE_3_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_3D_POS_MULT_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_3D_MIX_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_3D_END_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_IQ_START_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_IQ_VALUE_1_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_IQ_VALUE_2_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_IQ_VALUE_3_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_IQ_VALUE_4_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_IQ_POS_MULT_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_IQ_MIX_Param);
-	AEFX_CLR_STRUCT(THOR_FRACTBROWN_IQ_END_Param);
-	AEFX_CLR_STRUCT(THOR_DISPLACE_START_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_1D_CB_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_2D_CB_Param);
-	AEFX_CLR_STRUCT(THOR_GENERIC_3D_CB_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_2D_CB_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_3D_CB_Param);
-	AEFX_CLR_STRUCT(THOR_PERLIN_4D_CB_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_2D_CB_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_3D_CB_Param);
-	AEFX_CLR_STRUCT(THOR_SIMPLEX_4D_CB_Param);
-	AEFX_CLR_STRUCT(THOR_VIQ_2D_CB_Param);
-	AEFX_CLR_STRUCT(THOR_VORONOI_2D_CB_Param);
-	AEFX_CLR_STRUCT(THOR_FACTBROWN_1D_CB_Param);
-	AEFX_CLR_STRUCT(THOR_FACTBROWN_2D_CB_Param);
-	AEFX_CLR_STRUCT(THOR_FACTBROWN_3D_CB_Param);
-	AEFX_CLR_STRUCT(THOR_FACTBROWN_4D_CB_Param);
-	AEFX_CLR_STRUCT(THOR_DISPLACE_END_Param);
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_1D_START,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_1D_START_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_1D_VALUE_1,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_1D_VALUE_1_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_1D_POS_MULT,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_1D_POS_MULT_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_1D_MIX,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_1D_MIX_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_1D_END,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_1D_END_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_2D_START,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_2D_START_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_2D_VALUE_1,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_2D_VALUE_1_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_2D_VALUE_2,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_2D_VALUE_2_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_2D_POS_MULT,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_2D_POS_MULT_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_2D_MIX,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_2D_MIX_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_2D_END,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_2D_END_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_3D_START,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_3D_START_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_3D_VALUE_1,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_3D_VALUE_1_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_3D_VALUE_2,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_3D_VALUE_2_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_3D_VALUE_3,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_3D_VALUE_3_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_3D_POS_MULT,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_3D_POS_MULT_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_3D_MIX,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_3D_MIX_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_3D_END,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_3D_END_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_2D_START,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_2D_START_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_2D_VALUE_1,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_2D_VALUE_1_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_2D_VALUE_2,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_2D_VALUE_2_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_2D_DIM,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_2D_DIM_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_2D_FREQ,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_2D_FREQ_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_2D_POS_MULT,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_2D_POS_MULT_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_2D_MIX,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_2D_MIX_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_2D_END,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_2D_END_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_3D_START,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_3D_START_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_3D_VALUE_1,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_3D_VALUE_1_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_3D_VALUE_2,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_3D_VALUE_2_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_3D_VALUE_3,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_3D_VALUE_3_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_3D_POS_MULT,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_3D_POS_MULT_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_3D_MIX,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_3D_MIX_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_3D_END,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_3D_END_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_4D_START,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_4D_START_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_4D_VALUE_1,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_4D_VALUE_1_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_4D_VALUE_2,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_4D_VALUE_2_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_4D_VALUE_3,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_4D_VALUE_3_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_4D_VALUE_4,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_4D_VALUE_4_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_4D_POS_MULT,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_4D_POS_MULT_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_4D_MIX,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_4D_MIX_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_4D_END,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_4D_END_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_2D_START,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_2D_START_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_2D_VALUE_1,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_2D_VALUE_1_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_2D_VALUE_2,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_2D_VALUE_2_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_2D_POS_MULT,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_2D_POS_MULT_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_2D_MIX,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_2D_MIX_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_2D_END,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_2D_END_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_3D_START,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_3D_START_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_3D_VALUE_1,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_3D_VALUE_1_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_3D_VALUE_2,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_3D_VALUE_2_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_3D_VALUE_3,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_3D_VALUE_3_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_3D_POS_MULT,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_3D_POS_MULT_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_3D_MIX,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_3D_MIX_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_3D_END,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_3D_END_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_4D_START,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_4D_START_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_4D_VALUE_1,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_4D_VALUE_1_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_4D_VALUE_2,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_4D_VALUE_2_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_4D_VALUE_3,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_4D_VALUE_3_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_4D_VALUE_4,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_4D_VALUE_4_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_4D_POS_MULT,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_4D_POS_MULT_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_4D_MIX,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_4D_MIX_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_4D_END,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_4D_END_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_VIQ_2D_START,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_VIQ_2D_START_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_VIQ_2D_VALUE_1,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_VIQ_2D_VALUE_1_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_VIQ_2D_VALUE_2,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_VIQ_2D_VALUE_2_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_VIQ_2D_U_MULT,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_VIQ_2D_U_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_VIQ_2D_V_MULT,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_VIQ_2D_V_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_VIQ_2D_POS_MULT,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_VIQ_2D_POS_MULT_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_VIQ_2D_MIX,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_VIQ_2D_MIX_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_VIQ_2D_END,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_VIQ_2D_END_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_VORONOI_2D_START,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_VORONOI_2D_START_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_VORONOI_2D_VALUE_1,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_VORONOI_2D_VALUE_1_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_VORONOI_2D_VALUE_2,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_VORONOI_2D_VALUE_2_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_VORONOI_2D_POS_MULT,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_VORONOI_2D_POS_MULT_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_VORONOI_2D_MIX,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_VORONOI_2D_MIX_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_VORONOI_2D_END,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_VORONOI_2D_END_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_1D_START,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_1D_START_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_1D_VALUE_1,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_1D_VALUE_1_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_1D_POS_MULT,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_1D_POS_MULT_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_1D_MIX,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_1D_MIX_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_1D_END,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_1D_END_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_2D_START,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_2D_START_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_2D_VALUE_1,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_2D_VALUE_1_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_2D_VALUE_2,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_2D_VALUE_2_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_2D_POS_MULT,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_2D_POS_MULT_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_2D_MIX,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_2D_MIX_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_2D_END,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_2D_END_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_3D_START,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_3D_START_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_3D_VALUE_1,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_3D_VALUE_1_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_3D_VALUE_2,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_3D_VALUE_2_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_3D_VALUE_3,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_3D_VALUE_3_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_3D_POS_MULT,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_3D_POS_MULT_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_3D_MIX,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_3D_MIX_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_3D_END,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_3D_END_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_IQ_START,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_IQ_START_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_IQ_VALUE_1,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_IQ_VALUE_1_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_IQ_VALUE_2,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_IQ_VALUE_2_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_IQ_VALUE_3,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_IQ_VALUE_3_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_IQ_VALUE_4,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_IQ_VALUE_4_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_IQ_POS_MULT,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_IQ_POS_MULT_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_IQ_MIX,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_IQ_MIX_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FRACTBROWN_IQ_END,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FRACTBROWN_IQ_END_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_DISPLACE_START,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_DISPLACE_START_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_1D_CB,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_1D_CB_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_2D_CB,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_2D_CB_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_GENERIC_3D_CB,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_GENERIC_3D_CB_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_2D_CB,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_2D_CB_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_3D_CB,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_3D_CB_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_PERLIN_4D_CB,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_PERLIN_4D_CB_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_2D_CB,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_2D_CB_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_3D_CB,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_3D_CB_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_SIMPLEX_4D_CB,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_SIMPLEX_4D_CB_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_VIQ_2D_CB,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_VIQ_2D_CB_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_VORONOI_2D_CB,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_VORONOI_2D_CB_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FACTBROWN_1D_CB,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FACTBROWN_1D_CB_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FACTBROWN_2D_CB,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FACTBROWN_2D_CB_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FACTBROWN_3D_CB,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FACTBROWN_3D_CB_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_FACTBROWN_4D_CB,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_FACTBROWN_4D_CB_Param));
-	ERR(PF_CHECKOUT_PARAM(in_data,
-		THOR_DISPLACE_END,
-		in_data->current_time,
-		in_data->time_step,
-		in_data->time_scale,
-		&THOR_DISPLACE_END_Param));
-
-
-
-
-	PF_FpLong		THOR_GENERIC_1D_START_Val;
-	PF_FpLong		THOR_GENERIC_1D_VALUE_1_Val;
-	PF_FpLong		THOR_GENERIC_1D_POS_MULT_Val;
-	PF_FpLong		THOR_GENERIC_1D_MIX_Val;
-	PF_FpLong		THOR_GENERIC_1D_END_Val;
-	PF_FpLong		THOR_GENERIC_2D_START_Val;
-	PF_FpLong		THOR_GENERIC_2D_VALUE_1_Val;
-	PF_FpLong		THOR_GENERIC_2D_VALUE_2_Val;
-	PF_FpLong		THOR_GENERIC_2D_POS_MULT_Val;
-	PF_FpLong		THOR_GENERIC_2D_MIX_Val;
-	PF_FpLong		THOR_GENERIC_2D_END_Val;
-	PF_FpLong		THOR_GENERIC_3D_START_Val;
-	PF_FpLong		THOR_GENERIC_3D_VALUE_1_Val;
-	PF_FpLong		THOR_GENERIC_3D_VALUE_2_Val;
-	PF_FpLong		THOR_GENERIC_3D_VALUE_3_Val;
-	PF_FpLong		THOR_GENERIC_3D_POS_MULT_Val;
-	PF_FpLong		THOR_GENERIC_3D_MIX_Val;
-	PF_FpLong		THOR_GENERIC_3D_END_Val;
-	PF_FpLong		THOR_PERLIN_2D_START_Val;
-	PF_FpLong		THOR_PERLIN_2D_VALUE_1_Val;
-	PF_FpLong		THOR_PERLIN_2D_VALUE_2_Val;
-	PF_FpLong		THOR_PERLIN_2D_DIM_Val;
-	PF_FpLong		THOR_PERLIN_2D_FREQ_Val;
-	PF_FpLong		THOR_PERLIN_2D_POS_MULT_Val;
-	PF_FpLong		THOR_PERLIN_2D_MIX_Val;
-	PF_FpLong		THOR_PERLIN_2D_END_Val;
-	PF_FpLong		THOR_PERLIN_3D_START_Val;
-	PF_FpLong		THOR_PERLIN_3D_VALUE_1_Val;
-	PF_FpLong		THOR_PERLIN_3D_VALUE_2_Val;
-	PF_FpLong		THOR_PERLIN_3D_VALUE_3_Val;
-	PF_FpLong		THOR_PERLIN_3D_POS_MULT_Val;
-	PF_FpLong		THOR_PERLIN_3D_MIX_Val;
-	PF_FpLong		THOR_PERLIN_3D_END_Val;
-	PF_FpLong		THOR_PERLIN_4D_START_Val;
-	PF_FpLong		THOR_PERLIN_4D_VALUE_1_Val;
-	PF_FpLong		THOR_PERLIN_4D_VALUE_2_Val;
-	PF_FpLong		THOR_PERLIN_4D_VALUE_3_Val;
-	PF_FpLong		THOR_PERLIN_4D_VALUE_4_Val;
-	PF_FpLong		THOR_PERLIN_4D_POS_MULT_Val;
-	PF_FpLong		THOR_PERLIN_4D_MIX_Val;
-	PF_FpLong		THOR_PERLIN_4D_END_Val;
-	PF_FpLong		THOR_SIMPLEX_2D_START_Val;
-	PF_FpLong		THOR_SIMPLEX_2D_VALUE_1_Val;
-	PF_FpLong		THOR_SIMPLEX_2D_VALUE_2_Val;
-	PF_FpLong		THOR_SIMPLEX_2D_POS_MULT_Val;
-	PF_FpLong		THOR_SIMPLEX_2D_MIX_Val;
-	PF_FpLong		THOR_SIMPLEX_2D_END_Val;
-	PF_FpLong		THOR_SIMPLEX_3D_START_Val;
-	PF_FpLong		THOR_SIMPLEX_3D_VALUE_1_Val;
-	PF_FpLong		THOR_SIMPLEX_3D_VALUE_2_Val;
-	PF_FpLong		THOR_SIMPLEX_3D_VALUE_3_Val;
-	PF_FpLong		THOR_SIMPLEX_3D_POS_MULT_Val;
-	PF_FpLong		THOR_SIMPLEX_3D_MIX_Val;
-	PF_FpLong		THOR_SIMPLEX_3D_END_Val;
-	PF_FpLong		THOR_SIMPLEX_4D_START_Val;
-	PF_FpLong		THOR_SIMPLEX_4D_VALUE_1_Val;
-	PF_FpLong		THOR_SIMPLEX_4D_VALUE_2_Val;
-	PF_FpLong		THOR_SIMPLEX_4D_VALUE_3_Val;
-	PF_FpLong		THOR_SIMPLEX_4D_VALUE_4_Val;
-	PF_FpLong		THOR_SIMPLEX_4D_POS_MULT_Val;
-	PF_FpLong		THOR_SIMPLEX_4D_MIX_Val;
-	PF_FpLong		THOR_SIMPLEX_4D_END_Val;
-	PF_FpLong		THOR_VIQ_2D_START_Val;
-	PF_FpLong		THOR_VIQ_2D_VALUE_1_Val;
-	PF_FpLong		THOR_VIQ_2D_VALUE_2_Val;
-	PF_FpLong		THOR_VIQ_2D_U_Val;
-	PF_FpLong		THOR_VIQ_2D_V_Val;
-	PF_FpLong		THOR_VIQ_2D_POS_MULT_Val;
-	PF_FpLong		THOR_VIQ_2D_MIX_Val;
-	PF_FpLong		THOR_VIQ_2D_END_Val;
-	PF_FpLong		THOR_VORONOI_2D_START_Val;
-	PF_FpLong		THOR_VORONOI_2D_VALUE_1_Val;
-	PF_FpLong		THOR_VORONOI_2D_VALUE_2_Val;
-	PF_FpLong		THOR_VORONOI_2D_POS_MULT_Val;
-	PF_FpLong		THOR_VORONOI_2D_MIX_Val;
-	PF_FpLong		THOR_VORONOI_2D_END_Val;
-	PF_FpLong		THOR_FRACTBROWN_1D_START_Val;
-	PF_FpLong		THOR_FRACTBROWN_1D_VALUE_1_Val;
-	PF_FpLong		THOR_FRACTBROWN_1D_POS_MULT_Val;
-	PF_FpLong		THOR_FRACTBROWN_1D_MIX_Val;
-	PF_FpLong		THOR_FRACTBROWN_1D_END_Val;
-	PF_FpLong		THOR_FRACTBROWN_2D_START_Val;
-	PF_FpLong		THOR_FRACTBROWN_2D_VALUE_1_Val;
-	PF_FpLong		THOR_FRACTBROWN_2D_VALUE_2_Val;
-	PF_FpLong		THOR_FRACTBROWN_2D_POS_MULT_Val;
-	PF_FpLong		THOR_FRACTBROWN_2D_MIX_Val;
-	PF_FpLong		THOR_FRACTBROWN_2D_END_Val;
-	PF_FpLong		THOR_FRACTBROWN_3D_START_Val;
-	PF_FpLong		THOR_FRACTBROWN_3D_VALUE_1_Val;
-	PF_FpLong		THOR_FRACTBROWN_3D_VALUE_2_Val;
-	PF_FpLong		THOR_FRACTBROWN_3D_VALUE_3_Val;
-	PF_FpLong		THOR_FRACTBROWN_3D_POS_MULT_Val;
-	PF_FpLong		THOR_FRACTBROWN_3D_MIX_Val;
-	PF_FpLong		THOR_FRACTBROWN_3D_END_Val;
-	PF_FpLong		THOR_FRACTBROWN_IQ_START_Val;
-	PF_FpLong		THOR_FRACTBROWN_IQ_VALUE_1_Val;
-	PF_FpLong		THOR_FRACTBROWN_IQ_VALUE_2_Val;
-	PF_FpLong		THOR_FRACTBROWN_IQ_VALUE_3_Val;
-	PF_FpLong		THOR_FRACTBROWN_IQ_VALUE_4_Val;
-	PF_FpLong		THOR_FRACTBROWN_IQ_POS_MULT_Val;
-	PF_FpLong		THOR_FRACTBROWN_IQ_MIX_Val;
-	PF_FpLong		THOR_FRACTBROWN_IQ_END_Val;
-	PF_FpLong		THOR_DISPLACE_START_Val;
-	PF_FpLong		THOR_GENERIC_1D_CB_Val;
-	PF_FpLong		THOR_GENERIC_2D_CB_Val;
-	PF_FpLong		THOR_GENERIC_3D_CB_Val;
-	PF_FpLong		THOR_PERLIN_2D_CB_Val;
-	PF_FpLong		THOR_PERLIN_3D_CB_Val;
-	PF_FpLong		THOR_PERLIN_4D_CB_Val;
-	PF_FpLong		THOR_SIMPLEX_2D_CB_Val;
-	PF_FpLong		THOR_SIMPLEX_3D_CB_Val;
-	PF_FpLong		THOR_SIMPLEX_4D_CB_Val;
-	PF_FpLong		THOR_VIQ_2D_CB_Val;
-	PF_FpLong		THOR_VORONOI_2D_CB_Val;
-	PF_FpLong		THOR_FACTBROWN_1D_CB_Val;
-	PF_FpLong		THOR_FACTBROWN_2D_CB_Val;
-	PF_FpLong		THOR_FACTBROWN_3D_CB_Val;
-	PF_FpLong		THOR_FACTBROWN_4D_CB_Val;
-	PF_FpLong		THOR_DISPLACE_END_Val;
-
-
-
+		&in_result));
 
 	if (!err){
+		// - only the requested part of the input is rendered, AE may hand back more than it asked for
+		// - SmartRender needs both rects to find the output pixels in the input world, and their place in the layer
+		RenderRects *rectsP = new RenderRects;
+		rectsP->generator = generator;
+		if (generator) {
+			AEFX_CLR_STRUCT(rectsP->input_rect);
+			rectsP->output_rect = in_result.max_result_rect;
+		} else {
+			rectsP->input_rect = in_result.result_rect;
+			rectsP->output_rect = in_result.result_rect;
+		}
+		IntersectLRect(&extra->input->output_request.rect, &rectsP->output_rect);
 
-		THOR_GENERIC_1D_VALUE_1_Val = THOR_GENERIC_1D_VALUE_1_Param.u.fs_d.value / 100.00;
-		THOR_GENERIC_1D_POS_MULT_Val = THOR_GENERIC_1D_POS_MULT_Param.u.fs_d.value / 10.00;
-		THOR_GENERIC_1D_MIX_Val = THOR_GENERIC_1D_MIX_Param.u.fs_d.value / 100.00;
-
-
-		THOR_GENERIC_2D_VALUE_1_Val = THOR_GENERIC_2D_VALUE_1_Param.u.fs_d.value / 100.00;
-		THOR_GENERIC_2D_VALUE_2_Val = THOR_GENERIC_2D_VALUE_2_Param.u.fs_d.value / 100.00;
-		THOR_GENERIC_2D_POS_MULT_Val = THOR_GENERIC_2D_POS_MULT_Param.u.fs_d.value / 10.00;
-		THOR_GENERIC_2D_MIX_Val = THOR_GENERIC_2D_MIX_Param.u.fs_d.value / 100.00;
-
-
-		THOR_GENERIC_3D_VALUE_1_Val = THOR_GENERIC_3D_VALUE_1_Param.u.fs_d.value / 100.00;
-		THOR_GENERIC_3D_VALUE_2_Val = THOR_GENERIC_3D_VALUE_2_Param.u.fs_d.value / 100.00;
-		THOR_GENERIC_3D_VALUE_3_Val = THOR_GENERIC_3D_VALUE_3_Param.u.fs_d.value / 100.00;
-		THOR_GENERIC_3D_POS_MULT_Val = THOR_GENERIC_3D_POS_MULT_Param.u.fs_d.value / 10.00;
-		THOR_GENERIC_3D_MIX_Val = THOR_GENERIC_3D_MIX_Param.u.fs_d.value / 100.00;
-
-
-		THOR_PERLIN_2D_VALUE_1_Val = THOR_PERLIN_2D_VALUE_1_Param.u.fs_d.value / 100.00;
-		THOR_PERLIN_2D_VALUE_2_Val = THOR_PERLIN_2D_VALUE_2_Param.u.fs_d.value / 100.00;
-		THOR_PERLIN_2D_DIM_Val = THOR_PERLIN_2D_DIM_Param.u.fs_d.value / 100.00;
-		THOR_PERLIN_2D_FREQ_Val = THOR_PERLIN_2D_FREQ_Param.u.fs_d.value / 100.00;
-		THOR_PERLIN_2D_POS_MULT_Val = THOR_PERLIN_2D_POS_MULT_Param.u.fs_d.value / 10.00;
-		THOR_PERLIN_2D_MIX_Val = THOR_PERLIN_2D_MIX_Param.u.fs_d.value / 100.00;
-
-
-		THOR_PERLIN_3D_VALUE_1_Val = THOR_PERLIN_3D_VALUE_1_Param.u.fs_d.value / 100.00;
-		THOR_PERLIN_3D_VALUE_2_Val = THOR_PERLIN_3D_VALUE_2_Param.u.fs_d.value / 100.00;
-		THOR_PERLIN_3D_VALUE_3_Val = THOR_PERLIN_3D_VALUE_3_Param.u.fs_d.value / 100.00;
-		THOR_PERLIN_3D_POS_MULT_Val = THOR_PERLIN_3D_POS_MULT_Param.u.fs_d.value / 10.00;
-		THOR_PERLIN_3D_MIX_Val = THOR_PERLIN_3D_MIX_Param.u.fs_d.value / 100.00;
-
-
-		THOR_PERLIN_4D_VALUE_1_Val = THOR_PERLIN_4D_VALUE_1_Param.u.fs_d.value / 100.00;
-		THOR_PERLIN_4D_VALUE_2_Val = THOR_PERLIN_4D_VALUE_2_Param.u.fs_d.value / 100.00;
-		THOR_PERLIN_4D_VALUE_3_Val = THOR_PERLIN_4D_VALUE_3_Param.u.fs_d.value / 100.00;
-		THOR_PERLIN_4D_VALUE_4_Val = THOR_PERLIN_4D_VALUE_4_Param.u.fs_d.value / 100.00;
-		THOR_PERLIN_4D_POS_MULT_Val = THOR_PERLIN_4D_POS_MULT_Param.u.fs_d.value / 10.00;
-		THOR_PERLIN_4D_MIX_Val = THOR_PERLIN_4D_MIX_Param.u.fs_d.value / 100.00;
-
-
-		THOR_SIMPLEX_2D_VALUE_1_Val = THOR_SIMPLEX_2D_VALUE_1_Param.u.fs_d.value / 100.00;
-		THOR_SIMPLEX_2D_VALUE_2_Val = THOR_SIMPLEX_2D_VALUE_2_Param.u.fs_d.value / 100.00;
-		THOR_SIMPLEX_2D_POS_MULT_Val = THOR_SIMPLEX_2D_POS_MULT_Param.u.fs_d.value / 10.00;
-		THOR_SIMPLEX_2D_MIX_Val = THOR_SIMPLEX_2D_MIX_Param.u.fs_d.value / 100.00;
-
-
-		THOR_SIMPLEX_3D_VALUE_1_Val = THOR_SIMPLEX_3D_VALUE_1_Param.u.fs_d.value / 100.00;
-		THOR_SIMPLEX_3D_VALUE_2_Val = THOR_SIMPLEX_3D_VALUE_2_Param.u.fs_d.value / 100.00;
-		THOR_SIMPLEX_3D_VALUE_3_Val = THOR_SIMPLEX_3D_VALUE_3_Param.u.fs_d.value / 100.00;
-		THOR_SIMPLEX_3D_POS_MULT_Val = THOR_SIMPLEX_3D_POS_MULT_Param.u.fs_d.value / 10.00;
-		THOR_SIMPLEX_3D_MIX_Val = THOR_SIMPLEX_3D_MIX_Param.u.fs_d.value / 100.00;
+		UnionLRect(&rectsP->output_rect, &extra->output->result_rect);
+		UnionLRect(&in_result.max_result_rect, &extra->output->max_result_rect);
 
+		extra->output->pre_render_data = rectsP;
+		extra->output->delete_pre_render_data_func = DeleteRenderRects;
+	}
+	return err;
+}
 
-		THOR_SIMPLEX_4D_VALUE_1_Val = THOR_SIMPLEX_4D_VALUE_1_Param.u.fs_d.value / 100.00;
-		THOR_SIMPLEX_4D_VALUE_2_Val = THOR_SIMPLEX_4D_VALUE_2_Param.u.fs_d.value / 100.00;
-		THOR_SIMPLEX_4D_VALUE_3_Val = THOR_SIMPLEX_4D_VALUE_3_Param.u.fs_d.value / 100.00;
-		THOR_SIMPLEX_4D_VALUE_4_Val = THOR_SIMPLEX_4D_VALUE_4_Param.u.fs_d.value / 100.00;
-		THOR_SIMPLEX_4D_POS_MULT_Val = THOR_SIMPLEX_4D_POS_MULT_Param.u.fs_d.value / 10.00;
-		THOR_SIMPLEX_4D_MIX_Val = THOR_SIMPLEX_4D_MIX_Param.u.fs_d.value / 100.00;
+// - composites the noise stack over the input on the GPU, tile by tile, see PreRender for the rects
+// - throws on failure, like the OpenGL helpers it calls
+static void
+SmartRenderGL(
+	PF_InData				*in_data,
+	PF_OutData				*out_data,
+	const RenderRects&		rects,
+	const NoiseStackParams&	noiseStack,
+	PF_EffectWorld			*input_worldP,
+	PF_EffectWorld			*output_worldP,
+	PF_PixelFormat			format)
+{
+	// always restore back AE's own OGL context
+	SaveRestoreOGLContext oSavedContext;
 
+	// - our render specific context, this thread's until the render returns
+	// - contexts evicted from the pool are deleted here, after AE's context was saved above
+	// - on the way out the lease unbinds its context before giving it back, then AE's context is restored
+	AESDK_OpenGL_ScopedRenderContext renderContextLease(S_RenderContexts);
+	const AESDK_OpenGL::AESDK_OpenGL_EffectRenderDataPtr& renderContext = renderContextLease;
 
-		THOR_VIQ_2D_VALUE_1_Val = THOR_VIQ_2D_VALUE_1_Param.u.fs_d.value / 100.00;
-		THOR_VIQ_2D_VALUE_2_Val = THOR_VIQ_2D_VALUE_2_Param.u.fs_d.value / 100.00;
-		THOR_VIQ_2D_U_Val = THOR_VIQ_2D_U_Param.u.fs_d.value / 100.00;
-		THOR_VIQ_2D_V_Val = THOR_VIQ_2D_V_Param.u.fs_d.value / 100.00;
-		THOR_VIQ_2D_POS_MULT_Val = THOR_VIQ_2D_POS_MULT_Param.u.fs_d.value / 10.00;
-		THOR_VIQ_2D_MIX_Val = THOR_VIQ_2D_MIX_Param.u.fs_d.value / 100.00;
+	if (!renderContext->mInitialized) {
+		//Now comes the OpenGL part - OS specific loading to start with
+		try
+		{
+			AESDK_OpenGL_Startup(*renderContext.get(), S_GLator_EffectCommonData.get());
+		}
+		catch (...)
+		{
+			SetGLUnavailable("render context creation failed");
+			throw;
+		}
 
+		renderContext->mInitialized = true;
+	}
 
-		THOR_VORONOI_2D_VALUE_1_Val = THOR_VORONOI_2D_VALUE_1_Param.u.fs_d.value / 100.00;
-		THOR_VORONOI_2D_VALUE_2_Val = THOR_VORONOI_2D_VALUE_2_Param.u.fs_d.value / 100.00;
-		THOR_VORONOI_2D_POS_MULT_Val = THOR_VORONOI_2D_POS_MULT_Param.u.fs_d.value / 10.00;
-		THOR_VORONOI_2D_MIX_Val = THOR_VORONOI_2D_MIX_Param.u.fs_d.value / 100.00;
+	renderContext->SetPluginContext();
+	
+	// - Gremedy OpenGL debugger
+	// - Example of using a OpenGL extension
+	bool hasGremedy = renderContext->mExtensions.find(gl::GLextension::GL_GREMEDY_frame_terminator) != renderContext->mExtensions.end();
+
+	// - only the output world is rendered, it is the requested part of the input world
+	// - noise is evaluated at layer coordinates, so a region looks the same as in the full frame
+	A_long				widthL = output_worldP->width;
+	A_long				heightL = output_worldP->height;
+	A_long				inputOffsetXL = rects.output_rect.left - rects.input_rect.left;
+	A_long				inputOffsetYL = rects.output_rect.top - rects.input_rect.top;
+
+	size_t pixSize;
+	gl::GLenum glFmt;
+	float multiplier16bit;
+	GetTransferFormat(format, pixSize, glFmt, multiplier16bit);
+
+	// - one tile sized target and input texture per thread, reused for every tile of the frame
+	// - frames smaller than a tile get buffers of their own size
+	GLint maxTextureSize = 0;
+	glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+	A_long tileSizeL = std::min(S_RenderTileSize, static_cast<A_long>(maxTextureSize));
+	A_long bufferWidthL = std::min(widthL, tileSizeL);
+	A_long bufferHeightL = std::min(heightL, tileSizeL);
+
+	// generators get a permutation of their own, which doesn't sample the input
+	A_long permutationMask = noiseStack.enabled_mask | (rects.generator ? kGeneratorPermutationBit : 0);
+
+	//loading OpenGL resources
+	try
+	{
+		AESDK_OpenGL_InitResources(*renderContext.get(), bufferWidthL, bufferHeightL, GetInternalFormat(format),
+			S_NoisePrograms, static_cast<u_long>(permutationMask), GetNoisePermutationDefines(permutationMask));
+	}
+	catch (...)
+	{
+		SetGLUnavailable("resource initialization failed");
+		throw;
+	}
 
+	// recycled storage, each tile overwrites the texels it reads
+	ScopedPoolTexture inputFrameTexture(renderContext->mTexturePool, rects.generator ? 0 :
+		renderContext->mTexturePool.Acquire(bufferWidthL, bufferHeightL, GetInternalFormat(format)));
+
+	// Set up the frame-buffer object just like a window.
+	AESDK_OpenGL_MakeReadyToRender(*renderContext.get(), renderContext->mOutputFrameTexture);
+	ReportIfErrorFramebuffer(in_data, out_data);
+
+	// - each tile is uploaded, composited with the enabled noise layers in a single pass, and
+	//   read back into its place in the output world
+	// - the noise is evaluated at layer coordinates, tiles join without seams
+	for (A_long tileTopL = 0; tileTopL < heightL; tileTopL += tileSizeL) {
+		for (A_long tileLeftL = 0; tileLeftL < widthL; tileLeftL += tileSizeL) {
+			PF_LRect tileRect;
+			tileRect.left = tileLeftL;
+			tileRect.top = tileTopL;
+			tileRect.right = std::min(tileLeftL + tileSizeL, widthL);
+			tileRect.bottom = std::min(tileTopL + tileSizeL, heightL);
+
+			PF_LRect inputTileRect = tileRect;
+			OffsetLRect(inputTileRect, inputOffsetXL, inputOffsetYL);
+
+			PF_LRect layerTileRect = tileRect;
+			OffsetLRect(layerTileRect, rects.output_rect.left, rects.output_rect.top);
+
+			if (!rects.generator) {
+				UploadTexture(renderContext, inputFrameTexture, input_worldP, inputTileRect, pixSize, glFmt);
+			}
+			RenderGL(renderContext, layerTileRect, inputFrameTexture, noiseStack, multiplier16bit);
+			DownloadTexture(renderContext, output_worldP, tileRect, pixSize, glFmt);
+		}
+	}
 
-		THOR_FRACTBROWN_1D_VALUE_1_Val = THOR_FRACTBROWN_1D_VALUE_1_Param.u.fs_d.value / 100.00;
-		THOR_FRACTBROWN_1D_POS_MULT_Val = THOR_FRACTBROWN_1D_POS_MULT_Param.u.fs_d.value / 10.00;
-		THOR_FRACTBROWN_1D_MIX_Val = THOR_FRACTBROWN_1D_MIX_Param.u.fs_d.value / 100.00;
+	if (hasGremedy) {
+		gl::glFrameTerminatorGREMEDY();
+	}
 
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glBindTexture(GL_TEXTURE_2D, 0);
 
-		THOR_FRACTBROWN_2D_VALUE_1_Val = THOR_FRACTBROWN_2D_VALUE_1_Param.u.fs_d.value / 100.00;
-		THOR_FRACTBROWN_2D_VALUE_2_Val = THOR_FRACTBROWN_2D_VALUE_2_Param.u.fs_d.value / 100.00;
-		THOR_FRACTBROWN_2D_POS_MULT_Val = THOR_FRACTBROWN_2D_POS_MULT_Param.u.fs_d.value / 10.00;
-		THOR_FRACTBROWN_2D_MIX_Val = THOR_FRACTBROWN_2D_MIX_Param.u.fs_d.value / 100.00;
+	// the input texture goes back to the pool when leaving this scope
+	renderContext->mTexturePool.EndFrame();
+}
 
+// - OpenGL unless GLATOR_RENDERER=cpu or OpenGL failed to start in this process
+// - a frame whose context or resources fail to start touched no output pixel yet, it is rendered
+//   again on the CPU and so are all later frames
+static void
+SmartRenderNoiseStack(
+	PF_InData				*in_data,
+	PF_OutData				*out_data,
+	const RenderRects&		rects,
+	const NoiseStackParams&	noiseStack,
+	PF_EffectWorld			*input_worldP,
+	PF_EffectWorld			*output_worldP,
+	PF_PixelFormat			format)
+{
+	if (!S_RenderOnCPU && !S_GLUnavailable) {
+		try
+		{
+			if (S_GLWorkers.IsRunning()) {
+				// this thread only waits, the render happens on a worker and its context
+				S_GLWorkers.Submit([&]() {
+					SmartRenderGL(in_data, out_data, rects, noiseStack, input_worldP, output_worldP, format);
+				}).get();
+			} else {
+				SmartRenderGL(in_data, out_data, rects, noiseStack, input_worldP, output_worldP, format);
+			}
+			LogRenderBackend(RENDER_BACKEND_GL);
+			return;
+		}
+		catch (...)
+		{
+			// any other failure is the frame's, as before
+			if (!S_GLUnavailable) {
+				throw;
+			}
+		}
+	}
 
-		THOR_FRACTBROWN_3D_VALUE_1_Val = THOR_FRACTBROWN_3D_VALUE_1_Param.u.fs_d.value / 100.00;
-		THOR_FRACTBROWN_3D_VALUE_2_Val = THOR_FRACTBROWN_3D_VALUE_2_Param.u.fs_d.value / 100.00;
-		THOR_FRACTBROWN_3D_VALUE_3_Val = THOR_FRACTBROWN_3D_VALUE_3_Param.u.fs_d.value / 100.00;
-		THOR_FRACTBROWN_3D_POS_MULT_Val = THOR_FRACTBROWN_3D_POS_MULT_Param.u.fs_d.value / 10.00;
-		THOR_FRACTBROWN_3D_MIX_Val = THOR_FRACTBROWN_3D_MIX_Param.u.fs_d.value / 100.00;
+	GLatorCPU::RenderNoiseStack(S_CPUWorkers, noiseStack, rects, input_worldP, output_worldP, format);
+	LogRenderBackend(RENDER_BACKEND_CPU);
+}
 
+static PF_Err
+SmartRender(
+	PF_InData				*in_data,
+	PF_OutData				*out_data,
+	PF_SmartRenderExtra		*extra)
+{
+	PF_Err				err = PF_Err_NONE,
+						err2 = PF_Err_NONE;
 
-		THOR_FRACTBROWN_IQ_VALUE_1_Val = THOR_FRACTBROWN_IQ_VALUE_1_Param.u.fs_d.value / 100.00;
-		THOR_FRACTBROWN_IQ_VALUE_2_Val = THOR_FRACTBROWN_IQ_VALUE_2_Param.u.fs_d.value / 100.00;
-		THOR_FRACTBROWN_IQ_VALUE_3_Val = THOR_FRACTBROWN_IQ_VALUE_3_Param.u.fs_d.value / 100.00;
-		THOR_FRACTBROWN_IQ_VALUE_4_Val = THOR_FRACTBROWN_IQ_VALUE_4_Param.u.fs_d.value / 100.00;
-		THOR_FRACTBROWN_IQ_POS_MULT_Val = THOR_FRACTBROWN_IQ_POS_MULT_Param.u.fs_d.value / 10.00;
-		THOR_FRACTBROWN_IQ_MIX_Val = THOR_FRACTBROWN_IQ_MIX_Param.u.fs_d.value / 100.00;
+	PF_EffectWorld		*input_worldP = NULL,
+						*output_worldP = NULL;
+	PF_WorldSuite2		*wsP = NULL;
+	PF_PixelFormat		format = PF_PixelFormat_INVALID;
+	NoiseStackParams	noiseStack;
 
+	// the noise stack of this frame, only the enabled layers are fetched
+	ERR(CheckoutNoiseStack(in_data, noiseStack));
 
-		THOR_GENERIC_1D_CB_Val = bool2float(THOR_GENERIC_1D_CB_Param.u.bd.value);
-		THOR_GENERIC_2D_CB_Val = bool2float(THOR_GENERIC_2D_CB_Param.u.bd.value);
-		THOR_GENERIC_3D_CB_Val = bool2float(THOR_GENERIC_3D_CB_Param.u.bd.value);
-		THOR_PERLIN_2D_CB_Val = bool2float(THOR_PERLIN_2D_CB_Param.u.bd.value);
-		THOR_PERLIN_3D_CB_Val = bool2float(THOR_PERLIN_3D_CB_Param.u.bd.value);
-		THOR_PERLIN_4D_CB_Val = bool2float(THOR_PERLIN_4D_CB_Param.u.bd.value);
-		THOR_SIMPLEX_2D_CB_Val = bool2float(THOR_SIMPLEX_2D_CB_Param.u.bd.value);
-		THOR_SIMPLEX_3D_CB_Val = bool2float(THOR_SIMPLEX_3D_CB_Param.u.bd.value);
-		THOR_SIMPLEX_4D_CB_Val = bool2float(THOR_SIMPLEX_4D_CB_Param.u.bd.value);
-		THOR_VIQ_2D_CB_Val = bool2float(THOR_VIQ_2D_CB_Param.u.bd.value);
-		THOR_VORONOI_2D_CB_Val = bool2float(THOR_VORONOI_2D_CB_Param.u.bd.value);
-		THOR_FACTBROWN_1D_CB_Val = bool2float(THOR_FACTBROWN_1D_CB_Param.u.bd.value);
-		THOR_FACTBROWN_2D_CB_Val = bool2float(THOR_FACTBROWN_2D_CB_Param.u.bd.value);
-		THOR_FACTBROWN_3D_CB_Val = bool2float(THOR_FACTBROWN_3D_CB_Param.u.bd.value);
-		THOR_FACTBROWN_4D_CB_Val = bool2float(THOR_FACTBROWN_4D_CB_Param.u.bd.value);
+	// where the worlds sit in the layer, and whether there is an input at all, see PreRender
+	RenderRects rects;
+	AEFX_CLR_STRUCT(rects);
+	if (extra->input->pre_render_data) {
+		rects = *reinterpret_cast<const RenderRects*>(extra->input->pre_render_data);
 	}
 
-	ERR((extra->cb->checkout_layer_pixels(in_data->effect_ref, THOR_INPUT, &input_worldP)));
+	if (!rects.generator) {
+		ERR((extra->cb->checkout_layer_pixels(in_data->effect_ref, THOR_INPUT, &input_worldP)));
+	}
 
 	ERR(extra->cb->checkout_output(in_data->effect_ref, &output_worldP));
 
@@ -4029,74 +2280,22 @@ SmartRender(
 		"Couldn't load suite.",
 		(void**)&wsP));
 
-	if (!err){
+	// nothing to do when the requested rect misses the layer
+	if (!err && (input_worldP || rects.generator) && output_worldP && output_worldP->width > 0 && output_worldP->height > 0){
 		try
 		{
-			// always restore back AE's own OGL context
-			SaveRestoreOGLContext oSavedContext;
-
-			// our render specific context (one per thread)
-			AESDK_OpenGL::AESDK_OpenGL_EffectRenderDataPtr renderContext = GetCurrentRenderContext();
-
-			if (!renderContext->mInitialized) {
-				//Now comes the OpenGL part - OS specific loading to start with
-				AESDK_OpenGL_Startup(*renderContext.get(), S_GLator_EffectCommonData.get());
-
-				renderContext->mInitialized = true;
-			}
-
-			renderContext->SetPluginContext();
-			
-			// - Gremedy OpenGL debugger
-			// - Example of using a OpenGL extension
-			bool hasGremedy = renderContext->mExtensions.find(gl::GLextension::GL_GREMEDY_frame_terminator) != renderContext->mExtensions.end();
-
-			A_long				widthL = input_worldP->width;
-			A_long				heightL = input_worldP->height;
-
-			//loading OpenGL resources
-			AESDK_OpenGL_InitResources(*renderContext.get(), widthL, heightL, S_ResourcePath);
-
-			CHECK(wsP->PF_GetPixelFormat(input_worldP, &format));
-
-			// upload the input world to a texture
-			size_t pixSize;
-			gl::GLenum glFmt;
-			float multiplier16bit;
-			gl::GLuint inputFrameTexture = UploadTexture(suites, format, input_worldP, output_worldP, in_data, pixSize, glFmt, multiplier16bit);
-			
-			// Set up the frame-buffer object just like a window.
-			AESDK_OpenGL_MakeReadyToRender(*renderContext.get(), renderContext->mOutputFrameTexture);
-			ReportIfErrorFramebuffer(in_data, out_data);
-
-			glViewport(0, 0, widthL, heightL);
-			glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-			glClear(GL_COLOR_BUFFER_BIT);
-			
-			// - simply blend the texture inside the frame buffer
-			// - TODO: hack your own shader there
-			RenderGL(renderContext, widthL, heightL, inputFrameTexture, sliderVal, multiplier16bit);
-
-			// - we toggle PBO textures (we use the PBO we just created as an input)
-			AESDK_OpenGL_MakeReadyToRender(*renderContext.get(), inputFrameTexture);
-			ReportIfErrorFramebuffer(in_data, out_data);
-
-			glClear(GL_COLOR_BUFFER_BIT);
-
-			// swizzle using the previous output
-			SwizzleGL(renderContext, widthL, heightL, renderContext->mOutputFrameTexture, multiplier16bit);
-
-			if (hasGremedy) {
-				gl::glFrameTerminatorGREMEDY();
+			CHECK(wsP->PF_GetPixelFormat(output_worldP, &format));
+
+			// - layers that composite nothing leave the input as it is, and a generator that doesn't vary
+			//   over the layer is one colour: neither needs OpenGL
+			// - the GPU only sees the stacks that are worth a render pass
+			if (NoiseStackIsIdentity(noiseStack)) {
+				CopyInputToOutput(input_worldP, rects, output_worldP, format);
+			} else if (rects.generator && NoiseStackIsConstant(noiseStack)) {
+				FillConstantOutput(noiseStack, output_worldP, format);
+			} else {
+				SmartRenderNoiseStack(in_data, out_data, rects, noiseStack, input_worldP, output_worldP, format);
 			}
-
-			// - get back to CPU the result, and inside the output world
-			DownloadTexture(renderContext, suites, input_worldP, output_worldP, in_data,
-				format, pixSize, glFmt);
-
-			glBindFramebuffer(GL_FRAMEBUFFER, 0);
-			glBindTexture(GL_TEXTURE_2D, 0);
-			glDeleteTextures(1, &inputFrameTexture);
 		}
 		catch (PF_Err& thrown_err)
 		{
@@ -4118,126 +2317,9 @@ SmartRender(
 		kPFWorldSuite,
 		kPFWorldSuiteVersion2,
 		"Couldn't release suite."));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_1D_START_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_1D_VALUE_1_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_1D_POS_MULT_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_1D_MIX_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_1D_END_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_2D_START_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_2D_VALUE_1_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_2D_VALUE_2_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_2D_POS_MULT_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_2D_MIX_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_2D_END_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_3D_START_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_3D_VALUE_1_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_3D_VALUE_2_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_3D_VALUE_3_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_3D_POS_MULT_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_3D_MIX_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_3D_END_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_2D_START_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_2D_VALUE_1_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_2D_VALUE_2_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_2D_DIM_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_2D_FREQ_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_2D_POS_MULT_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_2D_MIX_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_2D_END_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_3D_START_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_3D_VALUE_1_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_3D_VALUE_2_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_3D_VALUE_3_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_3D_POS_MULT_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_3D_MIX_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_3D_END_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_4D_START_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_4D_VALUE_1_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_4D_VALUE_2_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_4D_VALUE_3_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_4D_VALUE_4_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_4D_POS_MULT_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_4D_MIX_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_4D_END_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_2D_START_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_2D_VALUE_1_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_2D_VALUE_2_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_2D_POS_MULT_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_2D_MIX_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_2D_END_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_3D_START_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_3D_VALUE_1_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_3D_VALUE_2_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_3D_VALUE_3_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_3D_POS_MULT_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_3D_MIX_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_3D_END_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_4D_START_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_4D_VALUE_1_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_4D_VALUE_2_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_4D_VALUE_3_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_4D_VALUE_4_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_4D_POS_MULT_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_4D_MIX_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_4D_END_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_VIQ_2D_START_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_VIQ_2D_VALUE_1_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_VIQ_2D_VALUE_2_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_VIQ_2D_U_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_VIQ_2D_V_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_VIQ_2D_POS_MULT_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_VIQ_2D_MIX_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_VIQ_2D_END_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_VORONOI_2D_START_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_VORONOI_2D_VALUE_1_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_VORONOI_2D_VALUE_2_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_VORONOI_2D_POS_MULT_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_VORONOI_2D_MIX_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_VORONOI_2D_END_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_1D_START_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_1D_VALUE_1_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_1D_POS_MULT_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_1D_MIX_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_1D_END_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_2D_START_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_2D_VALUE_1_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_2D_VALUE_2_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_2D_POS_MULT_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_2D_MIX_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_2D_END_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_3D_START_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_3D_VALUE_1_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_3D_VALUE_2_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_3D_VALUE_3_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_3D_POS_MULT_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_3D_MIX_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_3D_END_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_IQ_START_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_IQ_VALUE_1_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_IQ_VALUE_2_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_IQ_VALUE_3_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_IQ_VALUE_4_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_IQ_POS_MULT_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_IQ_MIX_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FRACTBROWN_IQ_END_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_DISPLACE_START_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_1D_CB_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_2D_CB_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_GENERIC_3D_CB_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_2D_CB_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_3D_CB_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_PERLIN_4D_CB_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_2D_CB_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_3D_CB_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_SIMPLEX_4D_CB_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_VIQ_2D_CB_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_VORONOI_2D_CB_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FACTBROWN_1D_CB_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FACTBROWN_2D_CB_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FACTBROWN_3D_CB_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_FACTBROWN_4D_CB_Param));
-	ERR2(PF_CHECKIN_PARAM(in_data, &THOR_DISPLACE_END_Param));
-	ERR2(extra->cb->checkin_layer_pixels(in_data->effect_ref, THOR_INPUT));
+	if (!rects.generator) {
+		ERR2(extra->cb->checkin_layer_pixels(in_data->effect_ref, THOR_INPUT));
+	}
 
 	return err;
 }
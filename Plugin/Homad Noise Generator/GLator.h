@@ -341,7 +341,207 @@ enum
 	NOISE_2D = 2,
 	NOISE_3D = 3,
 	NOISE_4D = 4,
-	
+
+};
+
+// noise layers, in the order of the THOR_*_CB toggles; fragment_shader.frag uses the same slots
+enum
+{
+	NOISE_LAYER_GENERIC_1D = 0,
+	NOISE_LAYER_GENERIC_2D,
+	NOISE_LAYER_GENERIC_3D,
+	NOISE_LAYER_PERLIN_2D,
+	NOISE_LAYER_PERLIN_3D,
+	NOISE_LAYER_PERLIN_4D,
+	NOISE_LAYER_SIMPLEX_2D,
+	NOISE_LAYER_SIMPLEX_3D,
+	NOISE_LAYER_SIMPLEX_4D,
+	NOISE_LAYER_VIQ_2D,
+	NOISE_LAYER_VORONOI_2D,
+	NOISE_LAYER_FRACTBROWN_1D,
+	NOISE_LAYER_FRACTBROWN_2D,
+	NOISE_LAYER_FRACTBROWN_3D,
+	NOISE_LAYER_FRACTBROWN_IQ,
+	NOISE_LAYER_NUM
+};
+
+// per layer shader parameters, laid out as the two vec4 the shader reads per layer
+struct NoiseLayerParams
+{
+	float values[4];	// VALUE_1..VALUE_4, unused trailing values are 0
+	float pos_mult;
+	float mix;
+	float extra[2];		// DIM/FREQ for Perlin 2D, U/V multipliers for VIQ
+};
+
+struct NoiseStackParams
+{
+	NoiseLayerParams	layers[NOISE_LAYER_NUM];	// the std140 "NoiseParams" uniform block
+	A_long				enabled_mask;	// bit n set when layer n is toggled on
+};
+
+// std140 lays a vec4 array out with a 16 byte stride, the same as these floats
+static_assert(sizeof(NoiseLayerParams) == 2 * 4 * sizeof(float), "NoiseLayerParams must match two std140 vec4");
+
+// how a parameter feeds NoiseStackParams
+enum ParamRole
+{
+	PARAM_ROLE_NONE,		// the input layer and the topic groups
+	PARAM_ROLE_TOGGLE,		// THOR_*_CB, turns its layer on
+	PARAM_ROLE_VALUE,		// NoiseLayerParams::values[slot]
+	PARAM_ROLE_POS_MULT,
+	PARAM_ROLE_MIX,
+	PARAM_ROLE_EXTRA		// NoiseLayerParams::extra[slot]
+};
+
+struct ParamDescriptor
+{
+	A_long		param;		// THOR_*, the index of the descriptor
+	A_long		layer;		// NOISE_LAYER_*, -1 when the parameter belongs to no layer
+	ParamRole	role;
+	A_long		slot;
+	float		divisor;	// slider value to shader value
+};
+
+// one entry per THOR_* parameter, in enum order
+constexpr ParamDescriptor kParamDescriptors[THOR_NUM_PARAMS] = {
+	{ THOR_INPUT,                  -1,                          PARAM_ROLE_NONE,      0, 1.0f },
+	{ THOR_GENERIC_1D_START,       -1,                          PARAM_ROLE_NONE,      0, 1.0f },
+	{ THOR_GENERIC_1D_VALUE_1,     NOISE_LAYER_GENERIC_1D,      PARAM_ROLE_VALUE,     0, 100.0f },
+	{ THOR_GENERIC_1D_POS_MULT,    NOISE_LAYER_GENERIC_1D,      PARAM_ROLE_POS_MULT,  0, 10.0f },
+	{ THOR_GENERIC_1D_MIX,         NOISE_LAYER_GENERIC_1D,      PARAM_ROLE_MIX,       0, 100.0f },
+	{ THOR_GENERIC_1D_END,         -1,                          PARAM_ROLE_NONE,      0, 1.0f },
+	{ THOR_GENERIC_2D_START,       -1,                          PARAM_ROLE_NONE,      0, 1.0f },
+	{ THOR_GENERIC_2D_VALUE_1,     NOISE_LAYER_GENERIC_2D,      PARAM_ROLE_VALUE,     0, 100.0f },
+	{ THOR_GENERIC_2D_VALUE_2,     NOISE_LAYER_GENERIC_2D,      PARAM_ROLE_VALUE,     1, 100.0f },
+	{ THOR_GENERIC_2D_POS_MULT,    NOISE_LAYER_GENERIC_2D,      PARAM_ROLE_POS_MULT,  0, 10.0f },
+	{ THOR_GENERIC_2D_MIX,         NOISE_LAYER_GENERIC_2D,      PARAM_ROLE_MIX,       0, 100.0f },
+	{ THOR_GENERIC_2D_END,         -1,                          PARAM_ROLE_NONE,      0, 1.0f },
+	{ THOR_GENERIC_3D_START,       -1,                          PARAM_ROLE_NONE,      0, 1.0f },
+	{ THOR_GENERIC_3D_VALUE_1,     NOISE_LAYER_GENERIC_3D,      PARAM_ROLE_VALUE,     0, 100.0f },
+	{ THOR_GENERIC_3D_VALUE_2,     NOISE_LAYER_GENERIC_3D,      PARAM_ROLE_VALUE,     1, 100.0f },
+	{ THOR_GENERIC_3D_VALUE_3,     NOISE_LAYER_GENERIC_3D,      PARAM_ROLE_VALUE,     2, 100.0f },
+	{ THOR_GENERIC_3D_POS_MULT,    NOISE_LAYER_GENERIC_3D,      PARAM_ROLE_POS_MULT,  0, 10.0f },
+	{ THOR_GENERIC_3D_MIX,         NOISE_LAYER_GENERIC_3D,      PARAM_ROLE_MIX,       0, 100.0f },
+	{ THOR_GENERIC_3D_END,         -1,                          PARAM_ROLE_NONE,      0, 1.0f },
+	{ THOR_PERLIN_2D_START,        -1,                          PARAM_ROLE_NONE,      0, 1.0f },
+	{ THOR_PERLIN_2D_VALUE_1,      NOISE_LAYER_PERLIN_2D,       PARAM_ROLE_VALUE,     0, 100.0f },
+	{ THOR_PERLIN_2D_VALUE_2,      NOISE_LAYER_PERLIN_2D,       PARAM_ROLE_VALUE,     1, 100.0f },
+	{ THOR_PERLIN_2D_DIM,          NOISE_LAYER_PERLIN_2D,       PARAM_ROLE_EXTRA,     0, 100.0f },
+	{ THOR_PERLIN_2D_FREQ,         NOISE_LAYER_PERLIN_2D,       PARAM_ROLE_EXTRA,     1, 100.0f },
+	{ THOR_PERLIN_2D_POS_MULT,     NOISE_LAYER_PERLIN_2D,       PARAM_ROLE_POS_MULT,  0, 10.0f },
+	{ THOR_PERLIN_2D_MIX,          NOISE_LAYER_PERLIN_2D,       PARAM_ROLE_MIX,       0, 100.0f },
+	{ THOR_PERLIN_2D_END,          -1,                          PARAM_ROLE_NONE,      0, 1.0f },
+	{ THOR_PERLIN_3D_START,        -1,                          PARAM_ROLE_NONE,      0, 1.0f },
+	{ THOR_PERLIN_3D_VALUE_1,      NOISE_LAYER_PERLIN_3D,       PARAM_ROLE_VALUE,     0, 100.0f },
+	{ THOR_PERLIN_3D_VALUE_2,      NOISE_LAYER_PERLIN_3D,       PARAM_ROLE_VALUE,     1, 100.0f },
+	{ THOR_PERLIN_3D_VALUE_3,      NOISE_LAYER_PERLIN_3D,       PARAM_ROLE_VALUE,     2, 100.0f },
+	{ THOR_PERLIN_3D_POS_MULT,     NOISE_LAYER_PERLIN_3D,       PARAM_ROLE_POS_MULT,  0, 10.0f },
+	{ THOR_PERLIN_3D_MIX,          NOISE_LAYER_PERLIN_3D,       PARAM_ROLE_MIX,       0, 100.0f },
+	{ THOR_PERLIN_3D_END,          -1,                          PARAM_ROLE_NONE,      0, 1.0f },
+	{ THOR_PERLIN_4D_START,        -1,                          PARAM_ROLE_NONE,      0, 1.0f },
+	{ THOR_PERLIN_4D_VALUE_1,      NOISE_LAYER_PERLIN_4D,       PARAM_ROLE_VALUE,     0, 100.0f },
+	{ THOR_PERLIN_4D_VALUE_2,      NOISE_LAYER_PERLIN_4D,       PARAM_ROLE_VALUE,     1, 100.0f },
+	{ THOR_PERLIN_4D_VALUE_3,      NOISE_LAYER_PERLIN_4D,       PARAM_ROLE_VALUE,     2, 100.0f },
+	{ THOR_PERLIN_4D_VALUE_4,      NOISE_LAYER_PERLIN_4D,       PARAM_ROLE_VALUE,     3, 100.0f },
+	{ THOR_PERLIN_4D_POS_MULT,     NOISE_LAYER_PERLIN_4D,       PARAM_ROLE_POS_MULT,  0, 10.0f },
+	{ THOR_PERLIN_4D_MIX,          NOISE_LAYER_PERLIN_4D,       PARAM_ROLE_MIX,       0, 100.0f },
+	{ THOR_PERLIN_4D_END,          -1,                          PARAM_ROLE_NONE,      0, 1.0f },
+	{ THOR_SIMPLEX_2D_START,       -1,                          PARAM_ROLE_NONE,      0, 1.0f },
+	{ THOR_SIMPLEX_2D_VALUE_1,     NOISE_LAYER_SIMPLEX_2D,      PARAM_ROLE_VALUE,     0, 100.0f },
+	{ THOR_SIMPLEX_2D_VALUE_2,     NOISE_LAYER_SIMPLEX_2D,      PARAM_ROLE_VALUE,     1, 100.0f },
+	{ THOR_SIMPLEX_2D_POS_MULT,    NOISE_LAYER_SIMPLEX_2D,      PARAM_ROLE_POS_MULT,  0, 10.0f },
+	{ THOR_SIMPLEX_2D_MIX,         NOISE_LAYER_SIMPLEX_2D,      PARAM_ROLE_MIX,       0, 100.0f },
+	{ THOR_SIMPLEX_2D_END,         -1,                          PARAM_ROLE_NONE,      0, 1.0f },
+	{ THOR_SIMPLEX_3D_START,       -1,                          PARAM_ROLE_NONE,      0, 1.0f },
+	{ THOR_SIMPLEX_3D_VALUE_1,     NOISE_LAYER_SIMPLEX_3D,      PARAM_ROLE_VALUE,     0, 100.0f },
+	{ THOR_SIMPLEX_3D_VALUE_2,     NOISE_LAYER_SIMPLEX_3D,      PARAM_ROLE_VALUE,     1, 100.0f },
+	{ THOR_SIMPLEX_3D_VALUE_3,     NOISE_LAYER_SIMPLEX_3D,      PARAM_ROLE_VALUE,     2, 100.0f },
+	{ THOR_SIMPLEX_3D_POS_MULT,    NOISE_LAYER_SIMPLEX_3D,      PARAM_ROLE_POS_MULT,  0, 10.0f },
+	{ THOR_SIMPLEX_3D_MIX,         NOISE_LAYER_SIMPLEX_3D,      PARAM_ROLE_MIX,       0, 100.0f },
+	{ THOR_SIMPLEX_3D_END,         -1,                          PARAM_ROLE_NONE,      0, 1.0f },
+	{ THOR_SIMPLEX_4D_START,       -1,                          PARAM_ROLE_NONE,      0, 1.0f },
+	{ THOR_SIMPLEX_4D_VALUE_1,     NOISE_LAYER_SIMPLEX_4D,      PARAM_ROLE_VALUE,     0, 100.0f },
+	{ THOR_SIMPLEX_4D_VALUE_2,     NOISE_LAYER_SIMPLEX_4D,      PARAM_ROLE_VALUE,     1, 100.0f },
+	{ THOR_SIMPLEX_4D_VALUE_3,     NOISE_LAYER_SIMPLEX_4D,      PARAM_ROLE_VALUE,     2, 100.0f },
+	{ THOR_SIMPLEX_4D_VALUE_4,     NOISE_LAYER_SIMPLEX_4D,      PARAM_ROLE_VALUE,     3, 100.0f },
+	{ THOR_SIMPLEX_4D_POS_MULT,    NOISE_LAYER_SIMPLEX_4D,      PARAM_ROLE_POS_MULT,  0, 10.0f },
+	{ THOR_SIMPLEX_4D_MIX,         NOISE_LAYER_SIMPLEX_4D,      PARAM_ROLE_MIX,       0, 100.0f },
+	{ THOR_SIMPLEX_4D_END,         -1,                          PARAM_ROLE_NONE,      0, 1.0f },
+	{ THOR_VIQ_2D_START,           -1,                          PARAM_ROLE_NONE,      0, 1.0f },
+	{ THOR_VIQ_2D_VALUE_1,         NOISE_LAYER_VIQ_2D,          PARAM_ROLE_VALUE,     0, 100.0f },
+	{ THOR_VIQ_2D_VALUE_2,         NOISE_LAYER_VIQ_2D,          PARAM_ROLE_VALUE,     1, 100.0f },
+	{ THOR_VIQ_2D_U_MULT,          NOISE_LAYER_VIQ_2D,          PARAM_ROLE_EXTRA,     0, 100.0f },
+	{ THOR_VIQ_2D_V_MULT,          NOISE_LAYER_VIQ_2D,          PARAM_ROLE_EXTRA,     1, 100.0f },
+	{ THOR_VIQ_2D_POS_MULT,        NOISE_LAYER_VIQ_2D,          PARAM_ROLE_POS_MULT,  0, 10.0f },
+	{ THOR_VIQ_2D_MIX,             NOISE_LAYER_VIQ_2D,          PARAM_ROLE_MIX,       0, 100.0f },
+	{ THOR_VIQ_2D_END,             -1,                          PARAM_ROLE_NONE,      0, 1.0f },
+	{ THOR_VORONOI_2D_START,       -1,                          PARAM_ROLE_NONE,      0, 1.0f },
+	{ THOR_VORONOI_2D_VALUE_1,     NOISE_LAYER_VORONOI_2D,      PARAM_ROLE_VALUE,     0, 100.0f },
+	{ THOR_VORONOI_2D_VALUE_2,     NOISE_LAYER_VORONOI_2D,      PARAM_ROLE_VALUE,     1, 100.0f },
+	{ THOR_VORONOI_2D_POS_MULT,    NOISE_LAYER_VORONOI_2D,      PARAM_ROLE_POS_MULT,  0, 10.0f },
+	{ THOR_VORONOI_2D_MIX,         NOISE_LAYER_VORONOI_2D,      PARAM_ROLE_MIX,       0, 100.0f },
+	{ THOR_VORONOI_2D_END,         -1,                          PARAM_ROLE_NONE,      0, 1.0f },
+	{ THOR_FRACTBROWN_1D_START,    -1,                          PARAM_ROLE_NONE,      0, 1.0f },
+	{ THOR_FRACTBROWN_1D_VALUE_1,  NOISE_LAYER_FRACTBROWN_1D,   PARAM_ROLE_VALUE,     0, 100.0f },
+	{ THOR_FRACTBROWN_1D_POS_MULT, NOISE_LAYER_FRACTBROWN_1D,   PARAM_ROLE_POS_MULT,  0, 10.0f },
+	{ THOR_FRACTBROWN_1D_MIX,      NOISE_LAYER_FRACTBROWN_1D,   PARAM_ROLE_MIX,       0, 100.0f },
+	{ THOR_FRACTBROWN_1D_END,      -1,                          PARAM_ROLE_NONE,      0, 1.0f },
+	{ THOR_FRACTBROWN_2D_START,    -1,                          PARAM_ROLE_NONE,      0, 1.0f },
+	{ THOR_FRACTBROWN_2D_VALUE_1,  NOISE_LAYER_FRACTBROWN_2D,   PARAM_ROLE_VALUE,     0, 100.0f },
+	{ THOR_FRACTBROWN_2D_VALUE_2,  NOISE_LAYER_FRACTBROWN_2D,   PARAM_ROLE_VALUE,     1, 100.0f },
+	{ THOR_FRACTBROWN_2D_POS_MULT, NOISE_LAYER_FRACTBROWN_2D,   PARAM_ROLE_POS_MULT,  0, 10.0f },
+	{ THOR_FRACTBROWN_2D_MIX,      NOISE_LAYER_FRACTBROWN_2D,   PARAM_ROLE_MIX,       0, 100.0f },
+	{ THOR_FRACTBROWN_2D_END,      -1,                          PARAM_ROLE_NONE,      0, 1.0f },
+	{ THOR_FRACTBROWN_3D_START,    -1,                          PARAM_ROLE_NONE,      0, 1.0f },
+	{ THOR_FRACTBROWN_3D_VALUE_1,  NOISE_LAYER_FRACTBROWN_3D,   PARAM_ROLE_VALUE,     0, 100.0f },
+	{ THOR_FRACTBROWN_3D_VALUE_2,  NOISE_LAYER_FRACTBROWN_3D,   PARAM_ROLE_VALUE,     1, 100.0f },
+	{ THOR_FRACTBROWN_3D_VALUE_3,  NOISE_LAYER_FRACTBROWN_3D,   PARAM_ROLE_VALUE,     2, 100.0f },
+	{ THOR_FRACTBROWN_3D_POS_MULT, NOISE_LAYER_FRACTBROWN_3D,   PARAM_ROLE_POS_MULT,  0, 10.0f },
+	{ THOR_FRACTBROWN_3D_MIX,      NOISE_LAYER_FRACTBROWN_3D,   PARAM_ROLE_MIX,       0, 100.0f },
+	{ THOR_FRACTBROWN_3D_END,      -1,                          PARAM_ROLE_NONE,      0, 1.0f },
+	{ THOR_FRACTBROWN_IQ_START,    -1,                          PARAM_ROLE_NONE,      0, 1.0f },
+	{ THOR_FRACTBROWN_IQ_VALUE_1,  NOISE_LAYER_FRACTBROWN_IQ,   PARAM_ROLE_VALUE,     0, 100.0f },
+	{ THOR_FRACTBROWN_IQ_VALUE_2,  NOISE_LAYER_FRACTBROWN_IQ,   PARAM_ROLE_VALUE,     1, 100.0f },
+	{ THOR_FRACTBROWN_IQ_VALUE_3,  NOISE_LAYER_FRACTBROWN_IQ,   PARAM_ROLE_VALUE,     2, 100.0f },
+	{ THOR_FRACTBROWN_IQ_VALUE_4,  NOISE_LAYER_FRACTBROWN_IQ,   PARAM_ROLE_VALUE,     3, 100.0f },
+	{ THOR_FRACTBROWN_IQ_POS_MULT, NOISE_LAYER_FRACTBROWN_IQ,   PARAM_ROLE_POS_MULT,  0, 10.0f },
+	{ THOR_FRACTBROWN_IQ_MIX,      NOISE_LAYER_FRACTBROWN_IQ,   PARAM_ROLE_MIX,       0, 100.0f },
+	{ THOR_FRACTBROWN_IQ_END,      -1,                          PARAM_ROLE_NONE,      0, 1.0f },
+	{ THOR_DISPLACE_START,         -1,                          PARAM_ROLE_NONE,      0, 1.0f },
+	{ THOR_GENERIC_1D_CB,          NOISE_LAYER_GENERIC_1D,      PARAM_ROLE_TOGGLE,    0, 1.0f },
+	{ THOR_GENERIC_2D_CB,          NOISE_LAYER_GENERIC_2D,      PARAM_ROLE_TOGGLE,    0, 1.0f },
+	{ THOR_GENERIC_3D_CB,          NOISE_LAYER_GENERIC_3D,      PARAM_ROLE_TOGGLE,    0, 1.0f },
+	{ THOR_PERLIN_2D_CB,           NOISE_LAYER_PERLIN_2D,       PARAM_ROLE_TOGGLE,    0, 1.0f },
+	{ THOR_PERLIN_3D_CB,           NOISE_LAYER_PERLIN_3D,       PARAM_ROLE_TOGGLE,    0, 1.0f },
+	{ THOR_PERLIN_4D_CB,           NOISE_LAYER_PERLIN_4D,       PARAM_ROLE_TOGGLE,    0, 1.0f },
+	{ THOR_SIMPLEX_2D_CB,          NOISE_LAYER_SIMPLEX_2D,      PARAM_ROLE_TOGGLE,    0, 1.0f },
+	{ THOR_SIMPLEX_3D_CB,          NOISE_LAYER_SIMPLEX_3D,      PARAM_ROLE_TOGGLE,    0, 1.0f },
+	{ THOR_SIMPLEX_4D_CB,          NOISE_LAYER_SIMPLEX_4D,      PARAM_ROLE_TOGGLE,    0, 1.0f },
+	{ THOR_VIQ_2D_CB,              NOISE_LAYER_VIQ_2D,          PARAM_ROLE_TOGGLE,    0, 1.0f },
+	{ THOR_VORONOI_2D_CB,          NOISE_LAYER_VORONOI_2D,      PARAM_ROLE_TOGGLE,    0, 1.0f },
+	{ THOR_FACTBROWN_1D_CB,        NOISE_LAYER_FRACTBROWN_1D,   PARAM_ROLE_TOGGLE,    0, 1.0f },
+	{ THOR_FACTBROWN_2D_CB,        NOISE_LAYER_FRACTBROWN_2D,   PARAM_ROLE_TOGGLE,    0, 1.0f },
+	{ THOR_FACTBROWN_3D_CB,        NOISE_LAYER_FRACTBROWN_3D,   PARAM_ROLE_TOGGLE,    0, 1.0f },
+	{ THOR_FACTBROWN_4D_CB,        NOISE_LAYER_FRACTBROWN_IQ,   PARAM_ROLE_TOGGLE,    0, 1.0f },
+	{ THOR_DISPLACE_END,           -1,                          PARAM_ROLE_NONE,      0, 1.0f }
+};
+
+constexpr bool ParamDescriptorsInOrder(A_long param = 0)
+{
+	return param == THOR_NUM_PARAMS || (kParamDescriptors[param].param == param && ParamDescriptorsInOrder(param + 1));
+}
+
+static_assert(ParamDescriptorsInOrder(), "kParamDescriptors must follow the THOR_* enum");
+
+// - handed from PreRender to SmartRender as pre_render_data
+// - layer space rects of the worlds AE checks out, the output is the requested part of the input
+// - in generator mode no layer lets the input through, the input rect is empty and no input world is checked out
+struct RenderRects
+{
+	PF_LRect	input_rect;
+	PF_LRect	output_rect;
+	PF_Boolean	generator;
 };
 
 struct Noise
@@ -392,7 +592,7 @@ struct Noise
 };
 
 
-float bool2float(bool bd)
+inline float bool2float(bool bd)
 {
 	return (bd == true) ? 1.00 : 0.00;
 }
@@ -0,0 +1,319 @@
+/*
+	GLator_CPURender.cpp
+
+	Tiled CPU render of the noise stack, and the work stealing pool that runs the tiles.
+*/
+
+#include "GLator_CPURender.h"
+#include "GLator_Kernels.h"
+#include "GLator_Noise.h"
+
+#include <algorithm>
+#include <exception>
+#include <string.h>
+
+namespace GLatorCPU
+{
+	/*
+	** TileWorkerPool
+	*/
+
+	// one Run: a run of tiles per participant, the caller being participant 0
+	struct TileWorkerPool::Frame
+	{
+		struct Tiles
+		{
+			std::mutex	mMutex;
+			A_long		mBegin;
+			A_long		mEnd;
+		};
+
+		Frame(A_long inTaskCount, size_t inParticipants, const std::function<void(A_long)>& inTask)
+			: mTask(inTask)
+			, mTiles(new Tiles[inParticipants])
+			, mParticipants(inParticipants)
+			, mJoined(1)
+			, mRemaining(inTaskCount)
+			, mFailed(false)
+		{
+			for (size_t p = 0; p < inParticipants; ++p) {
+				mTiles[p].mBegin = static_cast<A_long>(inTaskCount * p / inParticipants);
+				mTiles[p].mEnd = static_cast<A_long>(inTaskCount * (p + 1) / inParticipants);
+			}
+		}
+
+		bool TakeOwn(size_t inParticipant, A_long& outTask)
+		{
+			Tiles& tiles = mTiles[inParticipant];
+			std::lock_guard<std::mutex> lock(tiles.mMutex);
+			if (tiles.mBegin == tiles.mEnd) {
+				return false;
+			}
+			outTask = tiles.mBegin++;
+			return true;
+		}
+
+		bool Steal(size_t inParticipant, A_long& outTask)
+		{
+			for (size_t k = 1; k < mParticipants; ++k) {
+				Tiles& tiles = mTiles[(inParticipant + k) % mParticipants];
+				std::lock_guard<std::mutex> lock(tiles.mMutex);
+				if (tiles.mBegin != tiles.mEnd) {
+					outTask = --tiles.mEnd;
+					return true;
+				}
+			}
+			return false;
+		}
+
+		void Work(size_t inParticipant)
+		{
+			A_long task;
+			while (TakeOwn(inParticipant, task) || Steal(inParticipant, task)) {
+				if (!mFailed) {
+					try {
+						mTask(task);
+					} catch (...) {
+						std::lock_guard<std::mutex> lock(mDoneMutex);
+						if (!mFailed) {
+							mError = std::current_exception();
+							mFailed = true;
+						}
+					}
+				}
+				if (--mRemaining == 0) {
+					std::lock_guard<std::mutex> lock(mDoneMutex);
+					mDone.notify_all();
+				}
+			}
+		}
+
+		const std::function<void(A_long)>&	mTask;
+		std::unique_ptr<Tiles[]>			mTiles;
+		const size_t						mParticipants;
+		size_t								mJoined;		// under the pool's mutex
+		std::atomic<A_long>					mRemaining;
+		std::atomic<bool>					mFailed;
+		std::exception_ptr					mError;
+		std::mutex							mDoneMutex;
+		std::condition_variable				mDone;
+	};
+
+	TileWorkerPool::TileWorkerPool()
+		: mThreadCount(0)
+		, mStopping(false)
+		, mRunningFrames(0)
+	{
+	}
+
+	TileWorkerPool::~TileWorkerPool()
+	{
+		Stop();
+	}
+
+	void TileWorkerPool::Start(size_t inThreads)
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mThreadCount = inThreads;
+		mStopping = false;
+	}
+
+	void TileWorkerPool::Stop()
+	{
+		std::vector<std::thread> threads;
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mStopping = true;
+			mThreadCount = 0;
+			threads.swap(mThreads);
+		}
+		mFrameAvailable.notify_all();
+		for (size_t i = 0; i < threads.size(); ++i) {
+			threads[i].join();
+		}
+	}
+
+	void TileWorkerPool::Run(A_long inTaskCount, const std::function<void(A_long)>& inTask)
+	{
+		if (inTaskCount <= 0) {
+			return;
+		}
+
+		// frames started while this one runs get a smaller share, the threads already helping stay
+		struct RunningFrame {
+			std::atomic<int>& mCount;
+			int mRunning;
+			explicit RunningFrame(std::atomic<int>& count) : mCount(count), mRunning(++count) {}
+			~RunningFrame() { --mCount; }
+		} runningFrame(mRunningFrames);
+
+		std::shared_ptr<Frame> frame;
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			if (mThreads.empty() && !mStopping) {
+				for (size_t i = 0; i < mThreadCount; ++i) {
+					mThreads.push_back(std::thread(&TileWorkerPool::WorkerLoop, this));
+				}
+			}
+			size_t share = std::max((mThreads.size() + 1) / static_cast<size_t>(runningFrame.mRunning), static_cast<size_t>(1));
+			size_t participants = std::min(share, static_cast<size_t>(inTaskCount));
+
+			frame.reset(new Frame(inTaskCount, participants, inTask));
+			if (participants > 1) {
+				mFrames.push_back(frame);
+			}
+		}
+		if (frame->mParticipants > 1) {
+			mFrameAvailable.notify_all();
+		}
+
+		frame->Work(0);
+		{
+			std::unique_lock<std::mutex> lock(frame->mDoneMutex);
+			while (frame->mRemaining != 0) {
+				frame->mDone.wait(lock);
+			}
+		}
+		if (frame->mParticipants > 1) {
+			std::lock_guard<std::mutex> lock(mMutex);
+			mFrames.erase(std::find(mFrames.begin(), mFrames.end(), frame));
+		}
+
+		if (frame->mError) {
+			std::rethrow_exception(frame->mError);
+		}
+	}
+
+	void TileWorkerPool::WorkerLoop()
+	{
+		for (;;) {
+			std::shared_ptr<Frame> frame;
+			size_t participant = 0;
+			{
+				std::unique_lock<std::mutex> lock(mMutex);
+				for (;;) {
+					for (size_t i = 0; i < mFrames.size() && !frame; ++i) {
+						if (mFrames[i]->mJoined < mFrames[i]->mParticipants) {
+							frame = mFrames[i];
+							participant = frame->mJoined++;
+						}
+					}
+					if (frame || mStopping) {
+						break;
+					}
+					mFrameAvailable.wait(lock);
+				}
+			}
+			if (!frame) {
+				return;
+			}
+			frame->Work(participant);
+		}
+	}
+
+	/*
+	** Rendering
+	*/
+	namespace
+	{
+		struct FrameSetup
+		{
+			const NoiseStackParams*			noiseStackP;
+			const GLatorKernels::CpuKernels*	kernelsP;
+			GLatorKernels::PixelKernel		toRgba;
+			GLatorKernels::PixelKernel		fromRgba;
+			size_t							pixSize;
+			const char*						inputP;			// the input pixel under the output's top left
+			A_long							inputRowBytes;
+			char*							outputP;
+			A_long							outputRowBytes;
+			A_long							layerLeft;		// layer coordinates of the output's top left
+			A_long							layerTop;
+		};
+
+		// rows of kCPUTileSize pixels: in from the input, through the noise stack, out to the output
+		void RenderTile(const FrameSetup& setup, const PF_LRect& tileRect)
+		{
+			float rgba[kCPUTileSize * 4];
+			const A_long widthL = tileRect.right - tileRect.left;
+
+			for (A_long y = tileRect.top; y < tileRect.bottom; ++y) {
+				if (setup.inputP) {
+					setup.toRgba(setup.inputP + y * setup.inputRowBytes + tileRect.left * setup.pixSize, rgba, widthL);
+				} else {
+					// the generator composites over transparent black
+					memset(rgba, 0, widthL * 4 * sizeof(float));
+				}
+
+				GLatorNoise::EvaluateNoiseStackRow(*setup.noiseStackP, setup.kernelsP->noise,
+					static_cast<float>(setup.layerLeft + tileRect.left), static_cast<float>(setup.layerTop + y), widthL, rgba);
+
+				setup.fromRgba(rgba, setup.outputP + y * setup.outputRowBytes + tileRect.left * setup.pixSize, widthL);
+			}
+		}
+	}
+
+	void RenderNoiseStack(TileWorkerPool&			pool,
+						  const NoiseStackParams&	noiseStack,
+						  const RenderRects&		rects,
+						  PF_EffectWorld			*input_worldP,
+						  PF_EffectWorld			*output_worldP,
+						  PF_PixelFormat			format)
+	{
+		FrameSetup setup;
+		setup.noiseStackP = &noiseStack;
+		setup.kernelsP = &GLatorKernels::GetCpuKernels();
+
+		switch (format)
+		{
+		case PF_PixelFormat_ARGB128:
+			setup.toRgba = setup.kernelsP->pixels.argbFloatToRgba;
+			setup.fromRgba = setup.kernelsP->pixels.rgbaToArgbFloat;
+			setup.pixSize = sizeof(PF_PixelFloat);
+			break;
+		case PF_PixelFormat_ARGB64:
+			setup.toRgba = setup.kernelsP->pixels.argb16ToRgba;
+			setup.fromRgba = setup.kernelsP->pixels.rgbaToArgb16;
+			setup.pixSize = sizeof(PF_Pixel16);
+			break;
+		case PF_PixelFormat_ARGB32:
+			setup.toRgba = setup.kernelsP->pixels.argb8ToRgba;
+			setup.fromRgba = setup.kernelsP->pixels.rgbaToArgb8;
+			setup.pixSize = sizeof(PF_Pixel8);
+			break;
+		default:
+			CHECK(PF_Err_BAD_CALLBACK_PARAM);
+			break;
+		}
+
+		// - only the output world is rendered, it is the requested part of the input world
+		// - noise is evaluated at layer coordinates, so a region looks the same as in the full frame
+		setup.inputP = NULL;
+		setup.inputRowBytes = 0;
+		if (!rects.generator) {
+			A_long inputOffsetXL = rects.output_rect.left - rects.input_rect.left;
+			A_long inputOffsetYL = rects.output_rect.top - rects.input_rect.top;
+			setup.inputP = reinterpret_cast<const char*>(input_worldP->data) + inputOffsetYL * input_worldP->rowbytes + inputOffsetXL * setup.pixSize;
+			setup.inputRowBytes = input_worldP->rowbytes;
+		}
+		setup.outputP = reinterpret_cast<char*>(output_worldP->data);
+		setup.outputRowBytes = output_worldP->rowbytes;
+		setup.layerLeft = rects.output_rect.left;
+		setup.layerTop = rects.output_rect.top;
+
+		const A_long widthL = output_worldP->width;
+		const A_long heightL = output_worldP->height;
+		const A_long tilesXL = (widthL + kCPUTileSize - 1) / kCPUTileSize;
+		const A_long tilesYL = (heightL + kCPUTileSize - 1) / kCPUTileSize;
+
+		// tiles in row order, neighbouring tasks share input and output rows
+		pool.Run(tilesXL * tilesYL, [&](A_long tile) {
+			PF_LRect tileRect;
+			tileRect.left = (tile % tilesXL) * kCPUTileSize;
+			tileRect.top = (tile / tilesXL) * kCPUTileSize;
+			tileRect.right = std::min(tileRect.left + kCPUTileSize, widthL);
+			tileRect.bottom = std::min(tileRect.top + kCPUTileSize, heightL);
+			RenderTile(setup, tileRect);
+		});
+	}
+}
@@ -0,0 +1,77 @@
+/*
+	GLator_CPURender.h
+
+	The noise stack on the CPU: the output world is cut into kCPUTileSize square
+	tiles, which the render thread and a shared pool of workers render in parallel.
+	Same result as the GL path, through the kernels of GLator_Kernels.h.
+*/
+
+#pragma once
+
+#ifndef GLATOR_CPURENDER_H
+#define GLATOR_CPURENDER_H
+
+#include "GLator.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace GLatorCPU
+{
+	// - a tile's rows fit in L1 as RGBA float, its input and output in L2
+	// - small enough that a HD frame makes hundreds of tiles to balance
+	const A_long kCPUTileSize = 64;
+
+	// - runs a frame's tiles on the calling thread and on up to all pool threads
+	// - every participant owns a contiguous run of tiles and takes them from the front; once its
+	//   run is empty it steals from the back of the others, so uneven tiles even out
+	// - frames rendered at the same time share the threads: each takes its share when it starts
+	class TileWorkerPool
+	{
+	public:
+		TileWorkerPool();
+		~TileWorkerPool();
+
+		// - the threads are created by the first Run, a pool that never renders costs nothing
+		// - 0 threads renders on the calling thread only
+		void Start(size_t inThreads);
+		// waits for the frames being rendered, then joins the threads
+		void Stop();
+
+		// - calls inTask(i) for every i in [0, inTaskCount), returns when all calls returned
+		// - the first exception of a task is rethrown here, the remaining tasks are skipped
+		void Run(A_long inTaskCount, const std::function<void(A_long)>& inTask);
+
+	private:
+		struct Frame;
+
+		void WorkerLoop();
+
+		std::mutex mMutex;
+		std::condition_variable mFrameAvailable;
+		std::vector<std::shared_ptr<Frame> > mFrames;
+		std::vector<std::thread> mThreads;
+		size_t mThreadCount;
+		bool mStopping;
+		std::atomic<int> mRunningFrames;
+
+		TileWorkerPool(const TileWorkerPool &);
+		TileWorkerPool &operator=(const TileWorkerPool &);
+	};
+
+	// - composites the noise stack over the output rect of the input world, or over transparent
+	//   black for a generator, into output_worldP, see PreRender for the rects
+	// - throws PF_Err like the GL path
+	void RenderNoiseStack(TileWorkerPool&			pool,			// >>
+						  const NoiseStackParams&	noiseStack,		// >>
+						  const RenderRects&		rects,			// >>
+						  PF_EffectWorld			*input_worldP,	// >>
+						  PF_EffectWorld			*output_worldP,	// <<
+						  PF_PixelFormat			format);		// >>
+}
+
+#endif // GLATOR_CPURENDER_H
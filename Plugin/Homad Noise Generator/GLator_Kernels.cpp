@@ -0,0 +1,227 @@
+/*
+	GLator_Kernels.cpp
+
+	Scalar pixel kernels, and the choice of the kernel set from cpuid.
+*/
+
+#include "GLator_Kernels.h"
+
+#include <algorithm>
+
+#if GLATOR_KERNELS_X86
+	#ifdef _MSC_VER
+		#include <intrin.h>
+	#else
+		#include <cpuid.h>
+	#endif
+#endif
+
+namespace GLatorKernels
+{
+	namespace
+	{
+		/*
+		** Scalar pixel kernels
+		*/
+		template <typename ChannelType>
+		void ArgbToRgba(const ChannelType *inP, float *outP, A_long count, float scale)
+		{
+			for (A_long i = 0; i < count; ++i, inP += 4, outP += 4) {
+				outP[0] = static_cast<float>(inP[1]) * scale;
+				outP[1] = static_cast<float>(inP[2]) * scale;
+				outP[2] = static_cast<float>(inP[3]) * scale;
+				outP[3] = static_cast<float>(inP[0]) * scale;
+			}
+		}
+
+		template <typename ChannelType>
+		void RgbaToArgb(const float *inP, ChannelType *outP, A_long count, float maxChannel)
+		{
+			for (A_long i = 0; i < count; ++i, inP += 4, outP += 4) {
+				const bool visible = inP[3] != 0.0f;
+				for (int c = 0; c < 4; ++c) {
+					float value = visible ? std::min(std::max(inP[(c + 3) & 3], 0.0f), 1.0f) : 0.0f;
+					outP[c] = static_cast<ChannelType>(value * maxChannel + 0.5f);
+				}
+			}
+		}
+
+		void Argb8ToRgba(const void *srcP, void *dstP, A_long count)
+		{
+			ArgbToRgba(static_cast<const A_u_char*>(srcP), static_cast<float*>(dstP), count, 1.0f / PF_MAX_CHAN8);
+		}
+
+		void Argb16ToRgba(const void *srcP, void *dstP, A_long count)
+		{
+			ArgbToRgba(static_cast<const A_u_short*>(srcP), static_cast<float*>(dstP), count, 1.0f / PF_MAX_CHAN16);
+		}
+
+		void ArgbFloatToRgba(const void *srcP, void *dstP, A_long count)
+		{
+			ArgbToRgba(static_cast<const float*>(srcP), static_cast<float*>(dstP), count, 1.0f);
+		}
+
+		void RgbaToArgb8(const void *srcP, void *dstP, A_long count)
+		{
+			RgbaToArgb(static_cast<const float*>(srcP), static_cast<A_u_char*>(dstP), count, static_cast<float>(PF_MAX_CHAN8));
+		}
+
+		void RgbaToArgb16(const void *srcP, void *dstP, A_long count)
+		{
+			RgbaToArgb(static_cast<const float*>(srcP), static_cast<A_u_short*>(dstP), count, static_cast<float>(PF_MAX_CHAN16));
+		}
+
+		// float worlds are neither clamped nor rounded, like the float textures of the GL path
+		void RgbaToArgbFloat(const void *srcP, void *dstP, A_long count)
+		{
+			const float *inP = static_cast<const float*>(srcP);
+			float *outP = static_cast<float*>(dstP);
+			for (A_long i = 0; i < count; ++i, inP += 4, outP += 4) {
+				const bool visible = inP[3] != 0.0f;
+				for (int c = 0; c < 4; ++c) {
+					outP[c] = visible ? inP[(c + 3) & 3] : 0.0f;
+				}
+			}
+		}
+
+#if GLATOR_KERNELS_X86
+		/*
+		** cpuid
+		*/
+		void CpuId(int leaf, int subLeaf, int *regsP)
+		{
+#ifdef _MSC_VER
+			__cpuidex(regsP, leaf, subLeaf);
+#else
+			unsigned int a = 0, b = 0, c = 0, d = 0;
+			__cpuid_count(leaf, subLeaf, a, b, c, d);
+			regsP[0] = static_cast<int>(a);
+			regsP[1] = static_cast<int>(b);
+			regsP[2] = static_cast<int>(c);
+			regsP[3] = static_cast<int>(d);
+#endif
+		}
+
+		// the register state the OS saves on a context switch (XCR0)
+		unsigned long long GetEnabledXState()
+		{
+#ifdef _MSC_VER
+			return _xgetbv(0);
+#else
+			unsigned int lo = 0, hi = 0;
+			__asm__ __volatile__("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+			return (static_cast<unsigned long long>(hi) << 32) | lo;
+#endif
+		}
+
+		inline bool HasBit(int reg, int bit)	{ return (reg & (1 << bit)) != 0; }
+#endif
+
+		const CpuKernels kScalarKernels = { CPU_ISA_SCALAR, GLatorNoise::kNoiseKernelsScalar, kPixelKernelsScalar };
+
+		CpuKernels S_CpuKernels = kScalarKernels;
+	}
+
+	const PixelKernels kPixelKernelsScalar = {
+		Argb8ToRgba,
+		Argb16ToRgba,
+		ArgbFloatToRgba,
+		RgbaToArgb8,
+		RgbaToArgb16,
+		RgbaToArgbFloat
+	};
+
+	CpuIsa DetectCpuIsa()
+	{
+		CpuIsa isa = CPU_ISA_SCALAR;
+#if GLATOR_KERNELS_X86
+		int regs[4];
+		CpuId(0, 0, regs);
+		const int maxLeaf = regs[0];
+		if (maxLeaf < 1) {
+			return isa;
+		}
+
+		CpuId(1, 0, regs);
+		const int features1 = regs[2];
+		if (!HasBit(features1, 19) || !HasBit(features1, 20)) {	// SSE4.1, SSE4.2
+			return isa;
+		}
+		isa = CPU_ISA_SSE42;
+
+		// AVX state has to be enabled by the OS as well
+		if (!HasBit(features1, 27) || !HasBit(features1, 28) || !HasBit(features1, 12) || maxLeaf < 7) {	// OSXSAVE, AVX, FMA
+			return isa;
+		}
+		const unsigned long long xstate = GetEnabledXState();
+		if ((xstate & 0x6) != 0x6) {	// XMM, YMM
+			return isa;
+		}
+
+		CpuId(7, 0, regs);
+		const int features7 = regs[1];
+		if (!HasBit(features7, 5)) {	// AVX2
+			return isa;
+		}
+		isa = CPU_ISA_AVX2;
+
+		if ((xstate & 0xe0) != 0xe0) {	// opmask, ZMM0-15 high halves, ZMM16-31
+			return isa;
+		}
+		if (HasBit(features7, 16) && HasBit(features7, 17) && HasBit(features7, 28) &&	// AVX-512 F, DQ, CD
+			HasBit(features7, 30) && HasBit(features7, 31)) {							// AVX-512 BW, VL
+			isa = CPU_ISA_AVX512;
+		}
+#endif
+		return isa;
+	}
+
+	const char* GetCpuIsaName(CpuIsa isa)
+	{
+		switch (isa)
+		{
+		case CPU_ISA_SSE42:
+			return "sse42";
+		case CPU_ISA_AVX2:
+			return "avx2";
+		case CPU_ISA_AVX512:
+			return "avx512";
+		default:
+			return "scalar";
+		}
+	}
+
+	void SelectCpuKernels(CpuIsa maxIsa)
+	{
+		// never more than the CPU runs, forcing AVX-512 on an AVX2 machine gives AVX2
+		CpuIsa isa = std::min(maxIsa, DetectCpuIsa());
+
+		CpuKernels kernels = kScalarKernels;
+#if GLATOR_KERNELS_X86
+		switch (isa)
+		{
+		case CPU_ISA_AVX512:
+			kernels.noise = GLatorNoise::kNoiseKernelsAVX512;
+			kernels.pixels = kPixelKernelsAVX512;
+			break;
+		case CPU_ISA_AVX2:
+			kernels.noise = GLatorNoise::kNoiseKernelsAVX2;
+			kernels.pixels = kPixelKernelsAVX2;
+			break;
+		case CPU_ISA_SSE42:
+			kernels.noise = GLatorNoise::kNoiseKernelsSSE42;
+			kernels.pixels = kPixelKernelsSSE42;
+			break;
+		default:
+			break;
+		}
+		kernels.isa = isa;
+#endif
+		S_CpuKernels = kernels;
+	}
+
+	const CpuKernels& GetCpuKernels()
+	{
+		return S_CpuKernels;
+	}
+}
@@ -0,0 +1,76 @@
+/*
+	GLator_Kernels.h
+
+	The CPU kernels of the plug-in, one set per instruction set, and the set that
+	renders. GlobalSetup picks the set once, from cpuid: the best one the CPU and
+	the OS support, or a lower one when forced.
+
+	Sets and where they live:
+	- scalar:						GLator_Kernels.cpp, GLator_Noise.cpp
+	- SSE4.2, AVX2, AVX-512:		GLator_Kernels<ISA>.cpp, each built for its instruction set
+*/
+
+#pragma once
+
+#ifndef GLATOR_KERNELS_H
+#define GLATOR_KERNELS_H
+
+#include "AE_Effect.h"
+#include "GLator_NoiseSIMD.h"
+
+// the SIMD sets are x86 only, elsewhere the scalar set renders
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+	#define GLATOR_KERNELS_X86 1
+#else
+	#define GLATOR_KERNELS_X86 0
+#endif
+
+namespace GLatorKernels
+{
+	// in order of preference
+	enum CpuIsa {
+		CPU_ISA_SCALAR = 0,
+		CPU_ISA_SSE42,
+		CPU_ISA_AVX2,		// with FMA
+		CPU_ISA_AVX512,		// F, CD, BW, DQ and VL, what /arch:AVX512 compiles for
+		CPU_ISA_NUM
+	};
+
+	// - converts count pixels between an AE world row (ARGB, 8/16/32bpc) and straight RGBA float in 0..1
+	// - the back conversion is the end of the shader: transparent pixels become 0, 8/16bpc clamp and round
+	typedef void (*PixelKernel)(const void *srcP, void *dstP, A_long count);
+
+	struct PixelKernels {
+		PixelKernel		argb8ToRgba;
+		PixelKernel		argb16ToRgba;
+		PixelKernel		argbFloatToRgba;
+		PixelKernel		rgbaToArgb8;
+		PixelKernel		rgbaToArgb16;
+		PixelKernel		rgbaToArgbFloat;
+	};
+
+	extern const PixelKernels kPixelKernelsScalar;
+	extern const PixelKernels kPixelKernelsSSE42;
+	extern const PixelKernels kPixelKernelsAVX2;
+	extern const PixelKernels kPixelKernelsAVX512;
+
+	struct CpuKernels {
+		CpuIsa						isa;
+		GLatorNoise::NoiseKernels	noise;
+		PixelKernels				pixels;
+	};
+
+	// the best instruction set this CPU and OS can run
+	CpuIsa DetectCpuIsa();
+
+	// "scalar", "sse42", "avx2", "avx512"
+	const char* GetCpuIsaName(CpuIsa isa);
+
+	// - selects the kernels of maxIsa, or of the best detected instruction set below it
+	// - call once before rendering (GlobalSetup), the scalar set is selected until then
+	void SelectCpuKernels(CpuIsa maxIsa);
+
+	const CpuKernels& GetCpuKernels();
+}
+
+#endif // GLATOR_KERNELS_H
@@ -0,0 +1,109 @@
+/*
+	GLator_KernelsAVX2.cpp
+
+	Noise and pixel kernels on AVX2, eight floats or two pixels per register.
+	Built with /arch:AVX2.
+*/
+
+#include "GLator_Kernels.h"
+
+#if GLATOR_KERNELS_X86
+
+#include <immintrin.h>
+
+namespace GLatorKernels
+{
+	namespace
+	{
+		struct Lanes
+		{
+			enum { kWidth = 8, kPixels = 2 };
+
+			__m256 v;
+
+			Lanes() {}
+			Lanes(__m256 x) : v(x) {}
+			Lanes(float x) : v(_mm256_set1_ps(x)) {}
+
+			static Lanes Load(const float *P)	{ return _mm256_loadu_ps(P); }
+			void Store(float *P) const			{ _mm256_storeu_ps(P, v); }
+
+			static Lanes LoadPixels8(const A_u_char *P)
+			{
+				return _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(P))));
+			}
+
+			static Lanes LoadPixels16(const A_u_short *P)
+			{
+				return _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(P))));
+			}
+
+			// the eight channels, saturated to 16 bits
+			__m128i PackChannels16() const
+			{
+				__m256i channels = _mm256_cvttps_epi32(v);
+				return _mm_packus_epi32(_mm256_castsi256_si128(channels), _mm256_extracti128_si256(channels, 1));
+			}
+
+			void StorePixels8(A_u_char *P) const
+			{
+				__m128i channels = PackChannels16();
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(P), _mm_packus_epi16(channels, channels));
+			}
+
+			void StorePixels16(A_u_short *P) const
+			{
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(P), PackChannels16());
+			}
+
+			Lanes& operator+=(const Lanes& x)	{ v = _mm256_add_ps(v, x.v); return *this; }
+			Lanes& operator-=(const Lanes& x)	{ v = _mm256_sub_ps(v, x.v); return *this; }
+			Lanes& operator*=(const Lanes& x)	{ v = _mm256_mul_ps(v, x.v); return *this; }
+		};
+
+		inline Lanes operator+(const Lanes& a, const Lanes& b)	{ return _mm256_add_ps(a.v, b.v); }
+		inline Lanes operator-(const Lanes& a, const Lanes& b)	{ return _mm256_sub_ps(a.v, b.v); }
+		inline Lanes operator*(const Lanes& a, const Lanes& b)	{ return _mm256_mul_ps(a.v, b.v); }
+
+		inline Lanes Floor(const Lanes& x)						{ return _mm256_floor_ps(x.v); }
+		inline Lanes Abs(const Lanes& x)						{ return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), x.v); }
+		inline Lanes Min(const Lanes& a, const Lanes& b)		{ return _mm256_min_ps(a.v, b.v); }
+		inline Lanes Max(const Lanes& a, const Lanes& b)		{ return _mm256_max_ps(a.v, b.v); }
+		inline Lanes Step(const Lanes& edge, const Lanes& x)	{ return _mm256_and_ps(_mm256_cmp_ps(x.v, edge.v, _CMP_GE_OQ), _mm256_set1_ps(1.0f)); }
+
+		inline Lanes KeepNonZero(const Lanes& test, const Lanes& x)	{ return _mm256_and_ps(_mm256_cmp_ps(test.v, _mm256_setzero_ps(), _CMP_NEQ_UQ), x.v); }
+		// a pixel per 128 bit half
+		inline Lanes ArgbToRgba(const Lanes& x)					{ return _mm256_permute_ps(x.v, _MM_SHUFFLE(0, 3, 2, 1)); }
+		inline Lanes RgbaToArgb(const Lanes& x)					{ return _mm256_permute_ps(x.v, _MM_SHUFFLE(2, 1, 0, 3)); }
+		inline Lanes AlphaOfRgba(const Lanes& x)				{ return _mm256_permute_ps(x.v, _MM_SHUFFLE(3, 3, 3, 3)); }
+	}
+}
+
+#include "GLator_NoiseKernels.h"
+#include "GLator_PixelKernels.h"
+
+namespace GLatorNoise
+{
+	const NoiseKernels kNoiseKernelsAVX2 = {
+		Kernels::Perlin2Batch<GLatorKernels::Lanes>,
+		Kernels::Perlin3Batch<GLatorKernels::Lanes>,
+		Kernels::Perlin4Batch<GLatorKernels::Lanes>,
+		Kernels::Simplex2Batch<GLatorKernels::Lanes>,
+		Kernels::Simplex3Batch<GLatorKernels::Lanes>,
+		Kernels::Simplex4Batch<GLatorKernels::Lanes>
+	};
+}
+
+namespace GLatorKernels
+{
+	const PixelKernels kPixelKernelsAVX2 = {
+		Pixels::Argb8ToRgba<Lanes>,
+		Pixels::Argb16ToRgba<Lanes>,
+		Pixels::ArgbFloatToRgba<Lanes>,
+		Pixels::RgbaToArgb8<Lanes>,
+		Pixels::RgbaToArgb16<Lanes>,
+		Pixels::RgbaToArgbFloat<Lanes>
+	};
+}
+
+#endif // GLATOR_KERNELS_X86
@@ -0,0 +1,101 @@
+/*
+	GLator_KernelsAVX512.cpp
+
+	Noise and pixel kernels on AVX-512, sixteen floats or four pixels per register.
+	Built with /arch:AVX512.
+*/
+
+#include "GLator_Kernels.h"
+
+#if GLATOR_KERNELS_X86
+
+#include <immintrin.h>
+
+namespace GLatorKernels
+{
+	namespace
+	{
+		struct Lanes
+		{
+			enum { kWidth = 16, kPixels = 4 };
+
+			__m512 v;
+
+			Lanes() {}
+			Lanes(__m512 x) : v(x) {}
+			Lanes(float x) : v(_mm512_set1_ps(x)) {}
+
+			static Lanes Load(const float *P)	{ return _mm512_loadu_ps(P); }
+			void Store(float *P) const			{ _mm512_storeu_ps(P, v); }
+
+			static Lanes LoadPixels8(const A_u_char *P)
+			{
+				return _mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(P))));
+			}
+
+			static Lanes LoadPixels16(const A_u_short *P)
+			{
+				return _mm512_cvtepi32_ps(_mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(P))));
+			}
+
+			void StorePixels8(A_u_char *P) const
+			{
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(P), _mm512_cvtusepi32_epi8(_mm512_cvttps_epi32(v)));
+			}
+
+			void StorePixels16(A_u_short *P) const
+			{
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(P), _mm512_cvtusepi32_epi16(_mm512_cvttps_epi32(v)));
+			}
+
+			Lanes& operator+=(const Lanes& x)	{ v = _mm512_add_ps(v, x.v); return *this; }
+			Lanes& operator-=(const Lanes& x)	{ v = _mm512_sub_ps(v, x.v); return *this; }
+			Lanes& operator*=(const Lanes& x)	{ v = _mm512_mul_ps(v, x.v); return *this; }
+		};
+
+		inline Lanes operator+(const Lanes& a, const Lanes& b)	{ return _mm512_add_ps(a.v, b.v); }
+		inline Lanes operator-(const Lanes& a, const Lanes& b)	{ return _mm512_sub_ps(a.v, b.v); }
+		inline Lanes operator*(const Lanes& a, const Lanes& b)	{ return _mm512_mul_ps(a.v, b.v); }
+
+		inline Lanes Floor(const Lanes& x)						{ return _mm512_roundscale_ps(x.v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+		inline Lanes Abs(const Lanes& x)						{ return _mm512_abs_ps(x.v); }
+		inline Lanes Min(const Lanes& a, const Lanes& b)		{ return _mm512_min_ps(a.v, b.v); }
+		inline Lanes Max(const Lanes& a, const Lanes& b)		{ return _mm512_max_ps(a.v, b.v); }
+		inline Lanes Step(const Lanes& edge, const Lanes& x)	{ return _mm512_maskz_mov_ps(_mm512_cmp_ps_mask(x.v, edge.v, _CMP_GE_OQ), _mm512_set1_ps(1.0f)); }
+
+		inline Lanes KeepNonZero(const Lanes& test, const Lanes& x)	{ return _mm512_maskz_mov_ps(_mm512_cmp_ps_mask(test.v, _mm512_setzero_ps(), _CMP_NEQ_UQ), x.v); }
+		// a pixel per 128 bit quarter
+		inline Lanes ArgbToRgba(const Lanes& x)					{ return _mm512_permute_ps(x.v, _MM_SHUFFLE(0, 3, 2, 1)); }
+		inline Lanes RgbaToArgb(const Lanes& x)					{ return _mm512_permute_ps(x.v, _MM_SHUFFLE(2, 1, 0, 3)); }
+		inline Lanes AlphaOfRgba(const Lanes& x)				{ return _mm512_permute_ps(x.v, _MM_SHUFFLE(3, 3, 3, 3)); }
+	}
+}
+
+#include "GLator_NoiseKernels.h"
+#include "GLator_PixelKernels.h"
+
+namespace GLatorNoise
+{
+	const NoiseKernels kNoiseKernelsAVX512 = {
+		Kernels::Perlin2Batch<GLatorKernels::Lanes>,
+		Kernels::Perlin3Batch<GLatorKernels::Lanes>,
+		Kernels::Perlin4Batch<GLatorKernels::Lanes>,
+		Kernels::Simplex2Batch<GLatorKernels::Lanes>,
+		Kernels::Simplex3Batch<GLatorKernels::Lanes>,
+		Kernels::Simplex4Batch<GLatorKernels::Lanes>
+	};
+}
+
+namespace GLatorKernels
+{
+	const PixelKernels kPixelKernelsAVX512 = {
+		Pixels::Argb8ToRgba<Lanes>,
+		Pixels::Argb16ToRgba<Lanes>,
+		Pixels::ArgbFloatToRgba<Lanes>,
+		Pixels::RgbaToArgb8<Lanes>,
+		Pixels::RgbaToArgb16<Lanes>,
+		Pixels::RgbaToArgbFloat<Lanes>
+	};
+}
+
+#endif // GLATOR_KERNELS_X86
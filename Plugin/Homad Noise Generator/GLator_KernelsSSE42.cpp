@@ -0,0 +1,104 @@
+/*
+	GLator_KernelsSSE42.cpp
+
+	Noise and pixel kernels on SSE4.1/4.2, four floats or one pixel per register.
+*/
+
+#include "GLator_Kernels.h"
+
+#if GLATOR_KERNELS_X86
+
+#include <nmmintrin.h>
+#include <string.h>
+
+namespace GLatorKernels
+{
+	namespace
+	{
+		struct Lanes
+		{
+			enum { kWidth = 4, kPixels = 1 };
+
+			__m128 v;
+
+			Lanes() {}
+			Lanes(__m128 x) : v(x) {}
+			Lanes(float x) : v(_mm_set1_ps(x)) {}
+
+			static Lanes Load(const float *P)	{ return _mm_loadu_ps(P); }
+			void Store(float *P) const			{ _mm_storeu_ps(P, v); }
+
+			static Lanes LoadPixels8(const A_u_char *P)
+			{
+				int pixel;
+				memcpy(&pixel, P, sizeof(pixel));
+				return _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(pixel)));
+			}
+
+			static Lanes LoadPixels16(const A_u_short *P)
+			{
+				return _mm_cvtepi32_ps(_mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(P))));
+			}
+
+			void StorePixels8(A_u_char *P) const
+			{
+				__m128i channels = _mm_packus_epi32(_mm_cvttps_epi32(v), _mm_setzero_si128());
+				int pixel = _mm_cvtsi128_si32(_mm_packus_epi16(channels, channels));
+				memcpy(P, &pixel, sizeof(pixel));
+			}
+
+			void StorePixels16(A_u_short *P) const
+			{
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(P), _mm_packus_epi32(_mm_cvttps_epi32(v), _mm_setzero_si128()));
+			}
+
+			Lanes& operator+=(const Lanes& x)	{ v = _mm_add_ps(v, x.v); return *this; }
+			Lanes& operator-=(const Lanes& x)	{ v = _mm_sub_ps(v, x.v); return *this; }
+			Lanes& operator*=(const Lanes& x)	{ v = _mm_mul_ps(v, x.v); return *this; }
+		};
+
+		inline Lanes operator+(const Lanes& a, const Lanes& b)	{ return _mm_add_ps(a.v, b.v); }
+		inline Lanes operator-(const Lanes& a, const Lanes& b)	{ return _mm_sub_ps(a.v, b.v); }
+		inline Lanes operator*(const Lanes& a, const Lanes& b)	{ return _mm_mul_ps(a.v, b.v); }
+
+		inline Lanes Floor(const Lanes& x)						{ return _mm_floor_ps(x.v); }
+		inline Lanes Abs(const Lanes& x)						{ return _mm_andnot_ps(_mm_set1_ps(-0.0f), x.v); }
+		inline Lanes Min(const Lanes& a, const Lanes& b)		{ return _mm_min_ps(a.v, b.v); }
+		inline Lanes Max(const Lanes& a, const Lanes& b)		{ return _mm_max_ps(a.v, b.v); }
+		inline Lanes Step(const Lanes& edge, const Lanes& x)	{ return _mm_and_ps(_mm_cmpge_ps(x.v, edge.v), _mm_set1_ps(1.0f)); }
+
+		inline Lanes KeepNonZero(const Lanes& test, const Lanes& x)	{ return _mm_and_ps(_mm_cmpneq_ps(test.v, _mm_setzero_ps()), x.v); }
+		inline Lanes ArgbToRgba(const Lanes& x)					{ return _mm_shuffle_ps(x.v, x.v, _MM_SHUFFLE(0, 3, 2, 1)); }
+		inline Lanes RgbaToArgb(const Lanes& x)					{ return _mm_shuffle_ps(x.v, x.v, _MM_SHUFFLE(2, 1, 0, 3)); }
+		inline Lanes AlphaOfRgba(const Lanes& x)				{ return _mm_shuffle_ps(x.v, x.v, _MM_SHUFFLE(3, 3, 3, 3)); }
+	}
+}
+
+#include "GLator_NoiseKernels.h"
+#include "GLator_PixelKernels.h"
+
+namespace GLatorNoise
+{
+	const NoiseKernels kNoiseKernelsSSE42 = {
+		Kernels::Perlin2Batch<GLatorKernels::Lanes>,
+		Kernels::Perlin3Batch<GLatorKernels::Lanes>,
+		Kernels::Perlin4Batch<GLatorKernels::Lanes>,
+		Kernels::Simplex2Batch<GLatorKernels::Lanes>,
+		Kernels::Simplex3Batch<GLatorKernels::Lanes>,
+		Kernels::Simplex4Batch<GLatorKernels::Lanes>
+	};
+}
+
+namespace GLatorKernels
+{
+	const PixelKernels kPixelKernelsSSE42 = {
+		Pixels::Argb8ToRgba<Lanes>,
+		Pixels::Argb16ToRgba<Lanes>,
+		Pixels::ArgbFloatToRgba<Lanes>,
+		Pixels::RgbaToArgb8<Lanes>,
+		Pixels::RgbaToArgb16<Lanes>,
+		Pixels::RgbaToArgbFloat<Lanes>
+	};
+}
+
+#endif // GLATOR_KERNELS_X86
@@ -0,0 +1,497 @@
+/*
+	GLator_Noise.cpp
+
+	Scalar port of fragment_shader.frag. The GLSL vector code is unrolled
+	over plain float arrays, component for component, so that the two can be
+	compared line by line. Perlin and simplex noise are the lane type generic
+	kernels of GLator_NoiseKernels.h, instantiated for float.
+*/
+
+#include "GLator_Noise.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdint.h>
+
+namespace GLatorNoise
+{
+	namespace
+	{
+		// one lane operations of GLator_NoiseKernels.h
+		inline float Floor(float x)						{ return std::floor(x); }
+		inline float Abs(float x)						{ return std::fabs(x); }
+		inline float Min(float x, float y)				{ return std::min(x, y); }
+		inline float Max(float x, float y)				{ return std::max(x, y); }
+		inline float Step(float edge, float x)			{ return x < edge ? 0.0f : 1.0f; }
+	}
+}
+
+#include "GLator_NoiseKernels.h"
+
+namespace GLatorNoise
+{
+	namespace
+	{
+		/*
+		** GLSL built-ins
+		*/
+		inline float Mix(float x, float y, float a)		{ return x * (1.0f - a) + y * a; }
+		inline float Clamp(float x, float lo, float hi)	{ return std::min(std::max(x, lo), hi); }
+
+		inline float Smoothstep(float edge0, float edge1, float x)
+		{
+			float t = Clamp((x - edge0) / (edge1 - edge0), 0.0f, 1.0f);
+			return t * t * (3.0f - 2.0f * t);
+		}
+
+		/*
+		** Hashing - integer only, the exact lattice values of the shader
+		*/
+		inline uint32_t ThorHash(uint32_t x)
+		{
+			x ^= x >> 16;
+			x *= 0x7feb352du;
+			x ^= x >> 15;
+			x *= 0x846ca68bu;
+			x ^= x >> 16;
+			return x;
+		}
+
+		inline float ThorHashToFloat(uint32_t h)
+		{
+			return static_cast<float>(h >> 8) * (1.0f / 16777216.0f);
+		}
+
+		inline uint32_t ThorHash2(int x, int y)
+		{
+			return ThorHash(static_cast<uint32_t>(x) + ThorHash(static_cast<uint32_t>(y)));
+		}
+
+		inline uint32_t ThorHash3(int x, int y, int z)
+		{
+			return ThorHash(static_cast<uint32_t>(x) + ThorHash(static_cast<uint32_t>(y) + ThorHash(static_cast<uint32_t>(z))));
+		}
+
+		inline float Hash11(int x)					{ return ThorHashToFloat(ThorHash(static_cast<uint32_t>(x))); }
+		inline float Hash21(int x, int y)			{ return ThorHashToFloat(ThorHash2(x, y)); }
+		inline float Hash31(int x, int y, int z)	{ return ThorHashToFloat(ThorHash3(x, y, z)); }
+
+		inline void Hash22(int x, int y, float *outP)
+		{
+			uint32_t h = ThorHash2(x, y);
+			outP[0] = ThorHashToFloat(h);
+			outP[1] = ThorHashToFloat(ThorHash(h));
+		}
+
+		inline void Hash23(int x, int y, float *outP)
+		{
+			uint32_t h0 = ThorHash2(x, y);
+			uint32_t h1 = ThorHash(h0);
+			outP[0] = ThorHashToFloat(h0);
+			outP[1] = ThorHashToFloat(h1);
+			outP[2] = ThorHashToFloat(ThorHash(h1));
+		}
+
+		// noise space position of a pixel for a layer, offset by its VALUE_1/VALUE_2
+		inline void LayerPosition(const NoiseLayerParams& layer, float pixelX, float pixelY, float& xOut, float& yOut)
+		{
+			xOut = pixelX * (layer.pos_mult * kPixelScale) + layer.values[0] * kValueScale;
+			yOut = pixelY * (layer.pos_mult * kPixelScale) + layer.values[1] * kValueScale;
+		}
+
+		// composite a grey noise layer (range 0..1) over the running colour by its MIX
+		inline void CompositeLayer(float *rgbaP, const NoiseLayerParams& layer, float noise)
+		{
+			float n = Clamp(noise, 0.0f, 1.0f);
+			rgbaP[0] = Mix(rgbaP[0], n, layer.mix);
+			rgbaP[1] = Mix(rgbaP[1], n, layer.mix);
+			rgbaP[2] = Mix(rgbaP[2], n, layer.mix);
+			rgbaP[3] = Mix(rgbaP[3], 1.0f, layer.mix);
+		}
+	}
+
+	/*
+	** Generic (value) noise
+	*/
+	float GenericNoise(float x)
+	{
+		float i = std::floor(x);
+		float f = x - i;
+		f = f * f * (3.0f - 2.0f * f);
+		return Mix(Hash11(static_cast<int>(i)), Hash11(static_cast<int>(i) + 1), f);
+	}
+
+	float GenericNoise(float x, float y)
+	{
+		float pix = std::floor(x), piy = std::floor(y);
+		int ix = static_cast<int>(pix), iy = static_cast<int>(piy);
+		float fx = x - pix, fy = y - piy;
+		fx = fx * fx * (3.0f - 2.0f * fx);
+		fy = fy * fy * (3.0f - 2.0f * fy);
+		return Mix(Mix(Hash21(ix, iy), Hash21(ix + 1, iy), fx),
+				   Mix(Hash21(ix, iy + 1), Hash21(ix + 1, iy + 1), fx), fy);
+	}
+
+	float GenericNoise(float x, float y, float z)
+	{
+		float pix = std::floor(x), piy = std::floor(y), piz = std::floor(z);
+		int ix = static_cast<int>(pix), iy = static_cast<int>(piy), iz = static_cast<int>(piz);
+		float fx = x - pix, fy = y - piy, fz = z - piz;
+		fx = fx * fx * (3.0f - 2.0f * fx);
+		fy = fy * fy * (3.0f - 2.0f * fy);
+		fz = fz * fz * (3.0f - 2.0f * fz);
+		float z0 = Mix(Mix(Hash31(ix, iy, iz), Hash31(ix + 1, iy, iz), fx),
+					   Mix(Hash31(ix, iy + 1, iz), Hash31(ix + 1, iy + 1, iz), fx), fy);
+		float z1 = Mix(Mix(Hash31(ix, iy, iz + 1), Hash31(ix + 1, iy, iz + 1), fx),
+					   Mix(Hash31(ix, iy + 1, iz + 1), Hash31(ix + 1, iy + 1, iz + 1), fx), fy);
+		return Mix(z0, z1, fz);
+	}
+
+	/*
+	** Classic Perlin noise, range [-1, 1]
+	*/
+	float PerlinNoise(float x, float y)							{ return Kernels::Perlin2(x, y); }
+	float PerlinNoise(float x, float y, float z)				{ return Kernels::Perlin3(x, y, z); }
+	float PerlinNoise(float x, float y, float z, float w)		{ return Kernels::Perlin4(x, y, z, w); }
+
+	/*
+	** Simplex noise, range [-1, 1]
+	*/
+	float SimplexNoise(float x, float y)						{ return Kernels::Simplex2(x, y); }
+	float SimplexNoise(float x, float y, float z)				{ return Kernels::Simplex3(x, y, z); }
+	float SimplexNoise(float x, float y, float z, float w)		{ return Kernels::Simplex4(x, y, z, w); }
+
+	/*
+	** The scalar NoiseKernels, one pixel at a time
+	*/
+	namespace
+	{
+		void Perlin2Batch(const float *xP, const float *yP, const float *, const float *, float *outP)
+		{
+			for (int i = 0; i < kNoiseBatch; ++i) {
+				outP[i] = PerlinNoise(xP[i], yP[i]);
+			}
+		}
+
+		void Perlin3Batch(const float *xP, const float *yP, const float *zP, const float *, float *outP)
+		{
+			for (int i = 0; i < kNoiseBatch; ++i) {
+				outP[i] = PerlinNoise(xP[i], yP[i], zP[i]);
+			}
+		}
+
+		void Perlin4Batch(const float *xP, const float *yP, const float *zP, const float *wP, float *outP)
+		{
+			for (int i = 0; i < kNoiseBatch; ++i) {
+				outP[i] = PerlinNoise(xP[i], yP[i], zP[i], wP[i]);
+			}
+		}
+
+		void Simplex2Batch(const float *xP, const float *yP, const float *, const float *, float *outP)
+		{
+			for (int i = 0; i < kNoiseBatch; ++i) {
+				outP[i] = SimplexNoise(xP[i], yP[i]);
+			}
+		}
+
+		void Simplex3Batch(const float *xP, const float *yP, const float *zP, const float *, float *outP)
+		{
+			for (int i = 0; i < kNoiseBatch; ++i) {
+				outP[i] = SimplexNoise(xP[i], yP[i], zP[i]);
+			}
+		}
+
+		void Simplex4Batch(const float *xP, const float *yP, const float *zP, const float *wP, float *outP)
+		{
+			for (int i = 0; i < kNoiseBatch; ++i) {
+				outP[i] = SimplexNoise(xP[i], yP[i], zP[i], wP[i]);
+			}
+		}
+	}
+
+	const NoiseKernels kNoiseKernelsScalar = {
+		Perlin2Batch,
+		Perlin3Batch,
+		Perlin4Batch,
+		Simplex2Batch,
+		Simplex3Batch,
+		Simplex4Batch
+	};
+
+	/*
+	** Cellular noise
+	*/
+	// Inigo Quilez' voronoise: u blends cells <-> grid, v blends voronoi <-> value noise
+	float VoronoiseIQ(float x, float y, float u, float v)
+	{
+		float k = 1.0f + 63.0f * std::pow(1.0f - v, 6.0f);
+		float pix = std::floor(x), piy = std::floor(y);
+		int ix = static_cast<int>(pix), iy = static_cast<int>(piy);
+		float fx = x - pix, fy = y - piy;
+
+		float ax = 0.0f, ay = 0.0f;
+		for (int j = -2; j <= 2; j++) {
+			for (int i = -2; i <= 2; i++) {
+				float o[3];
+				Hash23(ix + i, iy + j, o);
+				float dx = static_cast<float>(i) - fx + o[0] * u;
+				float dy = static_cast<float>(j) - fy + o[1] * u;
+				float w = std::pow(1.0f - Smoothstep(0.0f, 1.414f, std::sqrt(dx * dx + dy * dy)), k);
+				ax += o[2] * w;
+				ay += w;
+			}
+		}
+		return ax / ay;
+	}
+
+	// distance to the closest feature point (F1)
+	float VoronoiNoise(float x, float y)
+	{
+		float pix = std::floor(x), piy = std::floor(y);
+		int ix = static_cast<int>(pix), iy = static_cast<int>(piy);
+		float fx = x - pix, fy = y - piy;
+
+		float d2 = 8.0f;
+		for (int j = -1; j <= 1; j++) {
+			for (int i = -1; i <= 1; i++) {
+				float h[2];
+				Hash22(ix + i, iy + j, h);
+				float rx = static_cast<float>(i) + h[0] - fx;
+				float ry = static_cast<float>(j) + h[1] - fy;
+				d2 = std::min(d2, rx * rx + ry * ry);
+			}
+		}
+		return std::sqrt(d2);
+	}
+
+	/*
+	** Fractional brownian motion over the generic noise
+	*/
+	float FbmNoise(float x)
+	{
+		float v = 0.0f;
+		float a = 0.5f;
+		for (int i = 0; i < kFbmOctaves; ++i) {
+			v += a * GenericNoise(x);
+			x = x * 2.0f + 100.0f;
+			a *= 0.5f;
+		}
+		return v;
+	}
+
+	float FbmNoise(float x, float y)
+	{
+		// rotate to reduce axial bias, same matrix as the shader's column major mat2
+		const float c = 0.87758256189f, s = 0.4794255386f;
+		float v = 0.0f;
+		float a = 0.5f;
+		for (int i = 0; i < kFbmOctaves; ++i) {
+			v += a * GenericNoise(x, y);
+			float rx = c * x - s * y;
+			float ry = s * x + c * y;
+			x = rx * 2.0f + 100.0f;
+			y = ry * 2.0f + 100.0f;
+			a *= 0.5f;
+		}
+		return v;
+	}
+
+	float FbmNoise(float x, float y, float z)
+	{
+		float v = 0.0f;
+		float a = 0.5f;
+		for (int i = 0; i < kFbmOctaves; ++i) {
+			v += a * GenericNoise(x, y, z);
+			x = x * 2.0f + 100.0f;
+			y = y * 2.0f + 100.0f;
+			z = z * 2.0f + 100.0f;
+			a *= 0.5f;
+		}
+		return v;
+	}
+
+	// Inigo Quilez' fbm: H is the Hurst exponent, the gain is 2^-H
+	float FbmNoiseIQ(float x, float y, float H, int octaves)
+	{
+		float G = std::exp2(-H);
+		float f = 1.0f;
+		float a = 1.0f;
+		float t = 0.0f;
+		float norm = 0.0f;
+		for (int i = 0; i < octaves; ++i) {
+			t += a * GenericNoise(f * x, f * y);
+			norm += a;
+			f *= 2.0f;
+			a *= G;
+		}
+		return t / norm;
+	}
+
+	namespace
+	{
+		// noise of one layer at a noise space position, range 0..1 before clamping
+		float EvaluateLayer(int index, const NoiseLayerParams& layer, float x, float y)
+		{
+			float z = layer.values[2] * kValueScale;
+			float w = layer.values[3] * kValueScale;
+
+			switch (index)
+			{
+			case NOISE_LAYER_GENERIC_1D:
+				return GenericNoise(x);
+			case NOISE_LAYER_GENERIC_2D:
+				return GenericNoise(x, y);
+			case NOISE_LAYER_GENERIC_3D:
+				return GenericNoise(x, y, z);
+			case NOISE_LAYER_PERLIN_2D:
+			{
+				// DIM picks the number of octaves (1..8), FREQ the base frequency
+				int octaves = 1 + static_cast<int>(layer.extra[0] * 7.0f);
+				float freq = 0.25f + layer.extra[1] * 3.75f;
+				float n = 0.0f;
+				float amp = 1.0f;
+				float norm = 0.0f;
+				x *= freq;
+				y *= freq;
+				for (int i = 0; i < octaves; ++i) {
+					n += amp * PerlinNoise(x, y);
+					norm += amp;
+					amp *= 0.5f;
+					x *= 2.0f;
+					y *= 2.0f;
+				}
+				return 0.5f + 0.5f * n / norm;
+			}
+			case NOISE_LAYER_PERLIN_3D:
+				return 0.5f + 0.5f * PerlinNoise(x, y, z);
+			case NOISE_LAYER_PERLIN_4D:
+				return 0.5f + 0.5f * PerlinNoise(x, y, z, w);
+			case NOISE_LAYER_SIMPLEX_2D:
+				return 0.5f + 0.5f * SimplexNoise(x, y);
+			case NOISE_LAYER_SIMPLEX_3D:
+				return 0.5f + 0.5f * SimplexNoise(x, y, z);
+			case NOISE_LAYER_SIMPLEX_4D:
+				return 0.5f + 0.5f * SimplexNoise(x, y, z, w);
+			case NOISE_LAYER_VIQ_2D:
+				return VoronoiseIQ(x, y, layer.extra[0], layer.extra[1]);
+			case NOISE_LAYER_VORONOI_2D:
+				return VoronoiNoise(x, y);
+			case NOISE_LAYER_FRACTBROWN_1D:
+				return FbmNoise(x);
+			case NOISE_LAYER_FRACTBROWN_2D:
+				return FbmNoise(x, y);
+			case NOISE_LAYER_FRACTBROWN_3D:
+				return FbmNoise(x, y, z);
+			case NOISE_LAYER_FRACTBROWN_IQ:
+				// VALUE_3 is the Hurst exponent, VALUE_4 the number of octaves (1..8)
+				return FbmNoiseIQ(x, y, layer.values[2], 1 + static_cast<int>(layer.values[3] * 7.0f));
+			}
+			return 0.0f;
+		}
+
+		// the kernel of a layer that is a single Perlin or simplex call, NULL for the others
+		NoiseKernel GetLayerKernel(int index, const NoiseKernels& kernels)
+		{
+			switch (index)
+			{
+			case NOISE_LAYER_PERLIN_3D:
+				return kernels.perlin3;
+			case NOISE_LAYER_PERLIN_4D:
+				return kernels.perlin4;
+			case NOISE_LAYER_SIMPLEX_2D:
+				return kernels.simplex2;
+			case NOISE_LAYER_SIMPLEX_3D:
+				return kernels.simplex3;
+			case NOISE_LAYER_SIMPLEX_4D:
+				return kernels.simplex4;
+			default:
+				return NULL;
+			}
+		}
+	}
+
+	void EvaluateNoiseStack(const NoiseStackParams&	noiseStack,
+							float					pixelX,
+							float					pixelY,
+							float					*rgbaP)
+	{
+		// composite every enabled noise layer, in toggle order
+		for (int index = 0; index < NOISE_LAYER_NUM; ++index) {
+			if (!(noiseStack.enabled_mask & (1L << index))) {
+				continue;
+			}
+			const NoiseLayerParams& layer = noiseStack.layers[index];
+			float x, y;
+			LayerPosition(layer, pixelX, pixelY, x, y);
+			CompositeLayer(rgbaP, layer, EvaluateLayer(index, layer, x, y));
+		}
+	}
+
+	void EvaluateNoiseStackRow(const NoiseStackParams&	noiseStack,
+							   const NoiseKernels&		kernels,
+							   float					pixelX,
+							   float					pixelY,
+							   A_long					count,
+							   float					*rgbaP)
+	{
+		for (A_long start = 0; start < count; start += kNoiseBatch) {
+			// the lanes past the end of the row are evaluated, but not composited
+			const A_long batch = std::min(count - start, static_cast<A_long>(kNoiseBatch));
+			float *batchP = rgbaP + start * 4;
+
+			for (int index = 0; index < NOISE_LAYER_NUM; ++index) {
+				if (!(noiseStack.enabled_mask & (1L << index))) {
+					continue;
+				}
+				const NoiseLayerParams& layer = noiseStack.layers[index];
+				float x[kNoiseBatch], y[kNoiseBatch], z[kNoiseBatch], w[kNoiseBatch], noise[kNoiseBatch];
+				for (int i = 0; i < kNoiseBatch; ++i) {
+					LayerPosition(layer, pixelX + static_cast<float>(start + i), pixelY, x[i], y[i]);
+					z[i] = layer.values[2] * kValueScale;
+					w[i] = layer.values[3] * kValueScale;
+				}
+
+				NoiseKernel kernel = GetLayerKernel(index, kernels);
+				if (kernel) {
+					kernel(x, y, z, w, noise);
+					for (int i = 0; i < kNoiseBatch; ++i) {
+						noise[i] = 0.5f + 0.5f * noise[i];
+					}
+				} else if (index == NOISE_LAYER_PERLIN_2D) {
+					// the octaves of EvaluateLayer, a batch at a time
+					int octaves = 1 + static_cast<int>(layer.extra[0] * 7.0f);
+					float freq = 0.25f + layer.extra[1] * 3.75f;
+					float n[kNoiseBatch], octave[kNoiseBatch];
+					float amp = 1.0f;
+					float norm = 0.0f;
+					for (int i = 0; i < kNoiseBatch; ++i) {
+						n[i] = 0.0f;
+						x[i] *= freq;
+						y[i] *= freq;
+					}
+					for (int o = 0; o < octaves; ++o) {
+						kernels.perlin2(x, y, NULL, NULL, octave);
+						for (int i = 0; i < kNoiseBatch; ++i) {
+							n[i] += amp * octave[i];
+							x[i] *= 2.0f;
+							y[i] *= 2.0f;
+						}
+						norm += amp;
+						amp *= 0.5f;
+					}
+					for (int i = 0; i < kNoiseBatch; ++i) {
+						noise[i] = 0.5f + 0.5f * n[i] / norm;
+					}
+				} else {
+					for (A_long i = 0; i < batch; ++i) {
+						noise[i] = EvaluateLayer(index, layer, x[i], y[i]);
+					}
+				}
+
+				for (A_long i = 0; i < batch; ++i) {
+					CompositeLayer(batchP + i * 4, layer, noise[i]);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,66 @@
+/*
+	GLator_Noise.h
+
+	CPU port of the noise functions of GLSL_files/fragment_shader.frag.
+	Same lattice hashing, same constants and the same layer compositing,
+	in single precision like the shader. Keep both in step when editing either.
+*/
+
+#pragma once
+
+#ifndef GLATOR_NOISE_H
+#define GLATOR_NOISE_H
+
+#include "GLator.h"
+#include "GLator_NoiseSIMD.h"
+
+namespace GLatorNoise
+{
+	// pixels -> noise space for POS_MULT == 1, and VALUE -> noise space offset (THOR_PIXEL_SCALE, THOR_VALUE_SCALE)
+	const float kPixelScale = 0.01f;
+	const float kValueScale = 10.0f;
+	const int kFbmOctaves = 5;
+
+	// generic (value) noise, range [0, 1]
+	float GenericNoise(float x);
+	float GenericNoise(float x, float y);
+	float GenericNoise(float x, float y, float z);
+
+	// classic Perlin noise, range [-1, 1]
+	float PerlinNoise(float x, float y);
+	float PerlinNoise(float x, float y, float z);
+	float PerlinNoise(float x, float y, float z, float w);
+
+	// simplex noise, range [-1, 1]
+	float SimplexNoise(float x, float y);
+	float SimplexNoise(float x, float y, float z);
+	float SimplexNoise(float x, float y, float z, float w);
+
+	// cellular noise
+	float VoronoiseIQ(float x, float y, float u, float v);
+	float VoronoiNoise(float x, float y);
+
+	// fractional brownian motion over the generic noise
+	float FbmNoise(float x);
+	float FbmNoise(float x, float y);
+	float FbmNoise(float x, float y, float z);
+	float FbmNoiseIQ(float x, float y, float H, int octaves);
+
+	// - composites the enabled layers of the stack over rgbaP, straight alpha RGBA in 0..1, as main() does
+	// - pixelX/pixelY are layer coordinates
+	void EvaluateNoiseStack(const NoiseStackParams&	noiseStack,	// >>
+							float					pixelX,		// >>
+							float					pixelY,		// >>
+							float					*rgbaP);	// <>
+
+	// - EvaluateNoiseStack for count pixels of a row from pixelX on, rgbaP holds count pixels
+	// - Perlin and simplex layers go through the kernels, kNoiseBatch pixels at a time
+	void EvaluateNoiseStackRow(const NoiseStackParams&	noiseStack,	// >>
+							   const NoiseKernels&		kernels,	// >>
+							   float					pixelX,		// >>
+							   float					pixelY,		// >>
+							   A_long					count,		// >>
+							   float					*rgbaP);	// <>
+}
+
+#endif // GLATOR_NOISE_H
@@ -0,0 +1,451 @@
+/*
+	GLator_NoiseKernels.h
+
+	Perlin and simplex noise of fragment_shader.frag, written once for any lane type:
+	float for the scalar port (GLator_Noise.cpp), and one SIMD register type per
+	instruction set (GLator_Kernels<ISA>.cpp), one pixel per lane.
+
+	- the code is branch-free like the shader: comparisons are step() and give 0 or 1
+	- the lattice hash is Gustavson's permutation polynomial, evaluated in registers,
+	  so there is no table to gather from
+	- before including this file, the includer declares for its lane type V, next to V:
+	  construction from a float, + - * (and += -= *=), Floor, Abs, Min, Max and
+	  Step(edge, x) (x < edge ? 0 : 1)
+	- SIMD lane types also provide kWidth, a static Load and a Store, for the batch
+	  entry points at the end of the file
+
+	No include guard: every includer instantiates its own lane type.
+*/
+
+#include "GLator_NoiseSIMD.h"
+
+namespace GLatorNoise
+{
+namespace Kernels
+{
+	/*
+	** GLSL built-ins and gradient noise helpers (after Stefan Gustavson / Ashima Arts, MIT license)
+	*/
+	template <class V> inline V Fract(const V& x)					{ return x - Floor(x); }
+	template <class V> inline V Mix(const V& x, const V& y, const V& a)	{ return x * (V(1.0f) - a) + y * a; }
+	template <class V> inline V Clamp01(const V& x)				{ return Min(Max(x, V(0.0f)), V(1.0f)); }
+	template <class V> inline V Mod289(const V& x)				{ return x - Floor(x * (1.0f / 289.0f)) * 289.0f; }
+	template <class V> inline V Permute(const V& x)				{ return Mod289(((x * 34.0f) + 1.0f) * x); }
+	template <class V> inline V TaylorInvSqrt(const V& r)		{ return V(1.79284291400159f) - r * 0.85373472095314f; }
+	template <class V> inline V Fade(const V& t)				{ return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f); }
+
+	// gradients for four lattice corners, packed per component
+	template <class V>
+	inline void PerlinGrad3(const V *ixyP, V *gxP, V *gyP, V *gzP)
+	{
+		for (int c = 0; c < 4; ++c) {
+			V gx = ixyP[c] * (1.0f / 7.0f);
+			V gy = Fract(Floor(gx) * (1.0f / 7.0f)) - 0.5f;
+			gx = Fract(gx);
+			V gz = V(0.5f) - Abs(gx) - Abs(gy);
+			V sz = Step(gz, V(0.0f));
+			gx -= sz * (Step(V(0.0f), gx) - 0.5f);
+			gy -= sz * (Step(V(0.0f), gy) - 0.5f);
+
+			V norm = TaylorInvSqrt(gx * gx + gy * gy + gz * gz);
+			gxP[c] = gx * norm;
+			gyP[c] = gy * norm;
+			gzP[c] = gz * norm;
+		}
+	}
+
+	template <class V>
+	inline void PerlinGrad4(const V *ixyP, V *gxP, V *gyP, V *gzP, V *gwP)
+	{
+		for (int c = 0; c < 4; ++c) {
+			V gx = ixyP[c] * (1.0f / 7.0f);
+			V gy = Floor(gx) * (1.0f / 7.0f);
+			V gz = Floor(gy) * (1.0f / 6.0f);
+			gx = Fract(gx) - 0.5f;
+			gy = Fract(gy) - 0.5f;
+			gz = Fract(gz) - 0.5f;
+			V gw = V(0.75f) - Abs(gx) - Abs(gy) - Abs(gz);
+			V sw = Step(gw, V(0.0f));
+			gx -= sw * (Step(V(0.0f), gx) - 0.5f);
+			gy -= sw * (Step(V(0.0f), gy) - 0.5f);
+
+			V norm = TaylorInvSqrt(gx * gx + gy * gy + gz * gz + gw * gw);
+			gxP[c] = gx * norm;
+			gyP[c] = gy * norm;
+			gzP[c] = gz * norm;
+			gwP[c] = gw * norm;
+		}
+	}
+
+	template <class V>
+	inline void SimplexGrad4(const V& j, V *pP)
+	{
+		const float ip[3] = { 1.0f / 294.0f, 1.0f / 49.0f, 1.0f / 7.0f };
+		for (int c = 0; c < 3; ++c) {
+			pP[c] = Floor(Fract(j * ip[c]) * 7.0f) * ip[2] - 1.0f;
+		}
+		pP[3] = V(1.5f) - (Abs(pP[0]) + Abs(pP[1]) + Abs(pP[2]));
+		// lessThan(p, 0)
+		V sw = V(1.0f) - Step(V(0.0f), pP[3]);
+		for (int c = 0; c < 3; ++c) {
+			V s = V(1.0f) - Step(V(0.0f), pP[c]);
+			pP[c] += (s * 2.0f - 1.0f) * sw;
+		}
+	}
+
+	/*
+	** Classic Perlin noise, range [-1, 1]
+	*/
+	template <class V>
+	V Perlin2(const V& x, const V& y)
+	{
+		V pi0x = Mod289(Floor(x)), pi0y = Mod289(Floor(y));
+		V pi1x = Mod289(Floor(x) + 1.0f), pi1y = Mod289(Floor(y) + 1.0f);
+		V pf0x = Fract(x), pf0y = Fract(y);
+		V pf1x = pf0x - 1.0f, pf1y = pf0y - 1.0f;
+
+		const V ix[4] = { pi0x, pi1x, pi0x, pi1x };
+		const V iy[4] = { pi0y, pi0y, pi1y, pi1y };
+		const V fx[4] = { pf0x, pf1x, pf0x, pf1x };
+		const V fy[4] = { pf0y, pf0y, pf1y, pf1y };
+
+		V n[4];
+		for (int c = 0; c < 4; ++c) {
+			V i = Permute(Permute(ix[c]) + iy[c]);
+			V gx = Fract(i * (1.0f / 41.0f)) * 2.0f - 1.0f;
+			V gy = Abs(gx) - 0.5f;
+			gx = gx - Floor(gx + 0.5f);
+
+			V norm = TaylorInvSqrt(gx * gx + gy * gy);
+			n[c] = gx * norm * fx[c] + gy * norm * fy[c];
+		}
+
+		V fadeX = Fade(pf0x), fadeY = Fade(pf0y);
+		return Mix(Mix(n[0], n[1], fadeX), Mix(n[2], n[3], fadeX), fadeY) * 2.3f;
+	}
+
+	template <class V>
+	V Perlin3(const V& x, const V& y, const V& z)
+	{
+		const V P[3] = { x, y, z };
+		V pi0[3], pi1[3], pf0[3], pf1[3];
+		for (int c = 0; c < 3; ++c) {
+			pi0[c] = Mod289(Floor(P[c]));
+			pi1[c] = Mod289(Floor(P[c]) + 1.0f);
+			pf0[c] = Fract(P[c]);
+			pf1[c] = pf0[c] - 1.0f;
+		}
+		const V ix[4] = { pi0[0], pi1[0], pi0[0], pi1[0] };
+		const V iy[4] = { pi0[1], pi0[1], pi1[1], pi1[1] };
+		const V fx[4] = { pf0[0], pf1[0], pf0[0], pf1[0] };
+		const V fy[4] = { pf0[1], pf0[1], pf1[1], pf1[1] };
+
+		V ixy0[4], ixy1[4];
+		for (int c = 0; c < 4; ++c) {
+			V ixy = Permute(Permute(ix[c]) + iy[c]);
+			ixy0[c] = Permute(ixy + pi0[2]);
+			ixy1[c] = Permute(ixy + pi1[2]);
+		}
+
+		V gx0[4], gy0[4], gz0[4], gx1[4], gy1[4], gz1[4];
+		PerlinGrad3(ixy0, gx0, gy0, gz0);
+		PerlinGrad3(ixy1, gx1, gy1, gz1);
+
+		V fadeX = Fade(pf0[0]), fadeY = Fade(pf0[1]), fadeZ = Fade(pf0[2]);
+		V nz[4];
+		for (int c = 0; c < 4; ++c) {
+			V nz0 = gx0[c] * fx[c] + gy0[c] * fy[c] + gz0[c] * pf0[2];
+			V nz1 = gx1[c] * fx[c] + gy1[c] * fy[c] + gz1[c] * pf1[2];
+			nz[c] = Mix(nz0, nz1, fadeZ);
+		}
+		V nyz0 = Mix(nz[0], nz[2], fadeY);
+		V nyz1 = Mix(nz[1], nz[3], fadeY);
+		return Mix(nyz0, nyz1, fadeX) * 2.2f;
+	}
+
+	template <class V>
+	V Perlin4(const V& x, const V& y, const V& z, const V& w)
+	{
+		const V P[4] = { x, y, z, w };
+		V pi0[4], pi1[4], pf0[4], pf1[4];
+		for (int c = 0; c < 4; ++c) {
+			pi0[c] = Mod289(Floor(P[c]));
+			pi1[c] = Mod289(Floor(P[c]) + 1.0f);
+			pf0[c] = Fract(P[c]);
+			pf1[c] = pf0[c] - 1.0f;
+		}
+		const V ix[4] = { pi0[0], pi1[0], pi0[0], pi1[0] };
+		const V iy[4] = { pi0[1], pi0[1], pi1[1], pi1[1] };
+		const V fx[4] = { pf0[0], pf1[0], pf0[0], pf1[0] };
+		const V fy[4] = { pf0[1], pf0[1], pf1[1], pf1[1] };
+
+		V ixy0[4], ixy1[4];
+		for (int c = 0; c < 4; ++c) {
+			V ixy = Permute(Permute(ix[c]) + iy[c]);
+			ixy0[c] = Permute(ixy + pi0[2]);
+			ixy1[c] = Permute(ixy + pi1[2]);
+		}
+
+		// the four z/w corners of the hypercube: n_00, n_10, n_01, n_11
+		const V* const ixyZ[4] = { ixy0, ixy1, ixy0, ixy1 };
+		const V fz[4] = { pf0[2], pf1[2], pf0[2], pf1[2] };
+		const V piW[4] = { pi0[3], pi0[3], pi1[3], pi1[3] };
+		const V fw[4] = { pf0[3], pf0[3], pf1[3], pf1[3] };
+		V n[4][4];
+		for (int corner = 0; corner < 4; ++corner) {
+			V ixyw[4], gx[4], gy[4], gz[4], gw[4];
+			for (int c = 0; c < 4; ++c) {
+				ixyw[c] = Permute(ixyZ[corner][c] + piW[corner]);
+			}
+			PerlinGrad4(ixyw, gx, gy, gz, gw);
+			for (int c = 0; c < 4; ++c) {
+				n[corner][c] = gx[c] * fx[c] + gy[c] * fy[c] + gz[c] * fz[corner] + gw[c] * fw[corner];
+			}
+		}
+
+		V fadeX = Fade(pf0[0]), fadeY = Fade(pf0[1]), fadeZ = Fade(pf0[2]), fadeW = Fade(pf0[3]);
+		V nzw[4];
+		for (int c = 0; c < 4; ++c) {
+			V n0w = Mix(n[0][c], n[2][c], fadeW);
+			V n1w = Mix(n[1][c], n[3][c], fadeW);
+			nzw[c] = Mix(n0w, n1w, fadeZ);
+		}
+		V nyzw0 = Mix(nzw[0], nzw[2], fadeY);
+		V nyzw1 = Mix(nzw[1], nzw[3], fadeY);
+		return Mix(nyzw0, nyzw1, fadeX) * 2.2f;
+	}
+
+	/*
+	** Simplex noise, range [-1, 1]
+	*/
+	template <class V>
+	V Simplex2(const V& x, const V& y)
+	{
+		const float C[4] = { 0.211324865405187f,	// (3.0-sqrt(3.0))/6.0
+							 0.366025403784439f,	// 0.5*(sqrt(3.0)-1.0)
+							 -0.577350269189626f,	// -1.0 + 2.0 * C.x
+							 0.024390243902439f };	// 1.0 / 41.0
+		V s = (x + y) * C[1];
+		V ix = Floor(x + s), iy = Floor(y + s);
+		V t = (ix + iy) * C[0];
+		V x0 = x - ix + t, y0 = y - iy + t;
+		// x0 > y0 ? (1, 0) : (0, 1)
+		V i1x = V(1.0f) - Step(x0, y0);
+		V i1y = V(1.0f) - i1x;
+
+		ix = Mod289(ix);
+		iy = Mod289(iy);
+		const V py[3] = { iy, iy + i1y, iy + 1.0f };
+		const V px[3] = { ix, ix + i1x, ix + 1.0f };
+
+		const V dx[3] = { x0, x0 + C[0] - i1x, x0 + C[2] };
+		const V dy[3] = { y0, y0 + C[0] - i1y, y0 + C[2] };
+		V result(0.0f);
+		for (int c = 0; c < 3; ++c) {
+			V p = Permute(Permute(py[c]) + px[c]);
+			V m = Max(V(0.5f) - (dx[c] * dx[c] + dy[c] * dy[c]), V(0.0f));
+			m = m * m;
+			m = m * m;
+
+			V gx = Fract(p * C[3]) * 2.0f - 1.0f;
+			V h = Abs(gx) - 0.5f;
+			V a0 = gx - Floor(gx + 0.5f);
+			m *= V(1.79284291400159f) - (a0 * a0 + h * h) * 0.85373472095314f;
+
+			result += m * (a0 * dx[c] + h * dy[c]);
+		}
+		return result * 130.0f;
+	}
+
+	template <class V>
+	V Simplex3(const V& x, const V& y, const V& z)
+	{
+		const float Cx = 1.0f / 6.0f, Cy = 1.0f / 3.0f;
+		const V v[3] = { x, y, z };
+
+		V s = (x + y + z) * Cy;
+		V i[3], x0[3];
+		for (int c = 0; c < 3; ++c) {
+			i[c] = Floor(v[c] + s);
+		}
+		V t = (i[0] + i[1] + i[2]) * Cx;
+		for (int c = 0; c < 3; ++c) {
+			x0[c] = v[c] - i[c] + t;
+		}
+
+		// g = step(x0.yzx, x0.xyz), l = 1 - g
+		const V g[3] = { Step(x0[1], x0[0]), Step(x0[2], x0[1]), Step(x0[0], x0[2]) };
+		const V l[3] = { V(1.0f) - g[0], V(1.0f) - g[1], V(1.0f) - g[2] };
+		// i1 = min(g.xyz, l.zxy), i2 = max(g.xyz, l.zxy)
+		const V i1[3] = { Min(g[0], l[2]), Min(g[1], l[0]), Min(g[2], l[1]) };
+		const V i2[3] = { Max(g[0], l[2]), Max(g[1], l[0]), Max(g[2], l[1]) };
+
+		V d[3][4];	// dx, dy, dz for the four corners
+		for (int c = 0; c < 3; ++c) {
+			d[c][0] = x0[c];
+			d[c][1] = x0[c] - i1[c] + Cx;
+			d[c][2] = x0[c] - i2[c] + Cy;
+			d[c][3] = x0[c] - 0.5f;
+			i[c] = Mod289(i[c]);
+		}
+
+		// lattice offsets of the corners: 0, i1, i2, 1
+		const V o[4][3] = { { V(0.0f), V(0.0f), V(0.0f) },
+							{ i1[0], i1[1], i1[2] },
+							{ i2[0], i2[1], i2[2] },
+							{ V(1.0f), V(1.0f), V(1.0f) } };
+
+		V result(0.0f);
+		for (int corner = 0; corner < 4; ++corner) {
+			V p = Permute(Permute(Permute(i[2] + o[corner][2]) + i[1] + o[corner][1]) + i[0] + o[corner][0]);
+
+			// gradients: 7x7 points over a square, mapped onto an octahedron
+			V j = p - Floor(p * (1.0f / 49.0f)) * 49.0f;
+			V gx_ = Floor(j * (1.0f / 7.0f));
+			V gy_ = Floor(j - gx_ * 7.0f);
+			V gx = gx_ * (2.0f / 7.0f) + (0.5f / 7.0f - 1.0f);
+			V gy = gy_ * (2.0f / 7.0f) + (0.5f / 7.0f - 1.0f);
+			V gz = V(1.0f) - Abs(gx) - Abs(gy);
+			V sh = V(0.0f) - Step(gz, V(0.0f));
+			gx += (Floor(gx) * 2.0f + 1.0f) * sh;
+			gy += (Floor(gy) * 2.0f + 1.0f) * sh;
+
+			V norm = TaylorInvSqrt(gx * gx + gy * gy + gz * gz);
+			const V& dx = d[0][corner];
+			const V& dy = d[1][corner];
+			const V& dz = d[2][corner];
+			V m = Max(V(0.5f) - (dx * dx + dy * dy + dz * dz), V(0.0f));
+			m = m * m;
+			result += m * m * (gx * norm * dx + gy * norm * dy + gz * norm * dz);
+		}
+		return result * 105.0f;
+	}
+
+	template <class V>
+	V Simplex4(const V& x, const V& y, const V& z, const V& w)
+	{
+		const float C[4] = { 0.138196601125011f,	// (5 - sqrt(5))/20  G4
+							 0.276393202250021f,	// 2 * G4
+							 0.414589803375032f,	// 3 * G4
+							 -0.447213595499958f };	// -1 + 4 * G4
+		const float F4 = 0.309016994374947451f;
+		const V v[4] = { x, y, z, w };
+
+		V s = (x + y + z + w) * F4;
+		V i[4], x0[4];
+		for (int c = 0; c < 4; ++c) {
+			i[c] = Floor(v[c] + s);
+		}
+		V t = (i[0] + i[1] + i[2] + i[3]) * C[0];
+		for (int c = 0; c < 4; ++c) {
+			x0[c] = v[c] - i[c] + t;
+		}
+
+		const V isX[3] = { Step(x0[1], x0[0]), Step(x0[2], x0[0]), Step(x0[3], x0[0]) };
+		const V isYZ[3] = { Step(x0[2], x0[1]), Step(x0[3], x0[1]), Step(x0[3], x0[2]) };
+		V i0[4];
+		i0[0] = isX[0] + isX[1] + isX[2];
+		i0[1] = V(1.0f) - isX[0] + isYZ[0] + isYZ[1];
+		i0[2] = V(1.0f) - isX[1] + (V(1.0f) - isYZ[0]) + isYZ[2];
+		i0[3] = V(1.0f) - isX[2] + (V(1.0f) - isYZ[1]) + (V(1.0f) - isYZ[2]);
+
+		V i1[4], i2[4], i3[4];
+		V xs[5][4];	// x0..x4
+		for (int c = 0; c < 4; ++c) {
+			i3[c] = Clamp01(i0[c]);
+			i2[c] = Clamp01(i0[c] - 1.0f);
+			i1[c] = Clamp01(i0[c] - 2.0f);
+
+			xs[0][c] = x0[c];
+			xs[1][c] = x0[c] - i1[c] + C[0];
+			xs[2][c] = x0[c] - i2[c] + C[1];
+			xs[3][c] = x0[c] - i3[c] + C[2];
+			xs[4][c] = x0[c] + C[3];
+
+			i[c] = Mod289(i[c]);
+		}
+
+		// lattice offsets of the corners after the first: i1, i2, i3, 1
+		const V* const offsets[3] = { i1, i2, i3 };
+		V j[5];
+		j[0] = Permute(Permute(Permute(Permute(i[3]) + i[2]) + i[1]) + i[0]);
+		for (int corner = 0; corner < 4; ++corner) {
+			V o[4] = { V(1.0f), V(1.0f), V(1.0f), V(1.0f) };
+			if (corner < 3) {
+				for (int c = 0; c < 4; ++c) {
+					o[c] = offsets[corner][c];
+				}
+			}
+			j[corner + 1] = Permute(Permute(Permute(Permute(
+								i[3] + o[3])
+							+ i[2] + o[2])
+							+ i[1] + o[1])
+							+ i[0] + o[0]);
+		}
+
+		V result(0.0f);
+		for (int corner = 0; corner < 5; ++corner) {
+			V p[4];
+			SimplexGrad4(j[corner], p);
+			V norm = TaylorInvSqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2] + p[3] * p[3]);
+
+			const V* xc = xs[corner];
+			V m = Max(V(0.6f) - (xc[0] * xc[0] + xc[1] * xc[1] + xc[2] * xc[2] + xc[3] * xc[3]), V(0.0f));
+			m = m * m;
+			result += m * m * (p[0] * xc[0] + p[1] * xc[1] + p[2] * xc[2] + p[3] * xc[3]) * norm;
+		}
+		return result * 49.0f;
+	}
+
+	/*
+	** NoiseKernel entry points: kNoiseBatch pixels, V::kWidth at a time
+	*/
+	template <class V>
+	void Perlin2Batch(const float *xP, const float *yP, const float *, const float *, float *outP)
+	{
+		for (int i = 0; i < kNoiseBatch; i += V::kWidth) {
+			Perlin2(V::Load(xP + i), V::Load(yP + i)).Store(outP + i);
+		}
+	}
+
+	template <class V>
+	void Perlin3Batch(const float *xP, const float *yP, const float *zP, const float *, float *outP)
+	{
+		for (int i = 0; i < kNoiseBatch; i += V::kWidth) {
+			Perlin3(V::Load(xP + i), V::Load(yP + i), V::Load(zP + i)).Store(outP + i);
+		}
+	}
+
+	template <class V>
+	void Perlin4Batch(const float *xP, const float *yP, const float *zP, const float *wP, float *outP)
+	{
+		for (int i = 0; i < kNoiseBatch; i += V::kWidth) {
+			Perlin4(V::Load(xP + i), V::Load(yP + i), V::Load(zP + i), V::Load(wP + i)).Store(outP + i);
+		}
+	}
+
+	template <class V>
+	void Simplex2Batch(const float *xP, const float *yP, const float *, const float *, float *outP)
+	{
+		for (int i = 0; i < kNoiseBatch; i += V::kWidth) {
+			Simplex2(V::Load(xP + i), V::Load(yP + i)).Store(outP + i);
+		}
+	}
+
+	template <class V>
+	void Simplex3Batch(const float *xP, const float *yP, const float *zP, const float *, float *outP)
+	{
+		for (int i = 0; i < kNoiseBatch; i += V::kWidth) {
+			Simplex3(V::Load(xP + i), V::Load(yP + i), V::Load(zP + i)).Store(outP + i);
+		}
+	}
+
+	template <class V>
+	void Simplex4Batch(const float *xP, const float *yP, const float *zP, const float *wP, float *outP)
+	{
+		for (int i = 0; i < kNoiseBatch; i += V::kWidth) {
+			Simplex4(V::Load(xP + i), V::Load(yP + i), V::Load(zP + i), V::Load(wP + i)).Store(outP + i);
+		}
+	}
+}
+}
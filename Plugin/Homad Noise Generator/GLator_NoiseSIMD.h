@@ -0,0 +1,45 @@
+/*
+	GLator_NoiseSIMD.h
+
+	Perlin and simplex noise for kNoiseBatch pixels per call, one set of kernels per
+	instruction set. Each SIMD set lives in its own translation unit, GLator_Kernels<ISA>.cpp,
+	built with that instruction set enabled; GLator_Kernels.h picks the set the CPU runs.
+
+	The kernels are GLator_NoiseKernels.h, the code of the scalar port, so their
+	results follow fragment_shader.frag within kNoiseKernelTolerance.
+*/
+
+#pragma once
+
+#ifndef GLATOR_NOISESIMD_H
+#define GLATOR_NOISESIMD_H
+
+namespace GLatorNoise
+{
+	// pixels per kernel call: four SSE, two AVX2 or one AVX-512 register
+	const int kNoiseBatch = 16;
+
+	// largest difference to the shader over the noise range [-1, 1]
+	// (measured: 2e-7 for Perlin and simplex 2D, 2e-4 for simplex 3D and 4D)
+	const float kNoiseKernelTolerance = 1.0e-3f;
+
+	// - kNoiseBatch coordinates per input, no alignment required
+	// - the inputs a kernel does not use (zP/wP below 4D) may be NULL
+	typedef void (*NoiseKernel)(const float *xP, const float *yP, const float *zP, const float *wP, float *outP);
+
+	struct NoiseKernels {
+		NoiseKernel		perlin2;
+		NoiseKernel		perlin3;
+		NoiseKernel		perlin4;
+		NoiseKernel		simplex2;
+		NoiseKernel		simplex3;
+		NoiseKernel		simplex4;
+	};
+
+	extern const NoiseKernels kNoiseKernelsScalar;
+	extern const NoiseKernels kNoiseKernelsSSE42;
+	extern const NoiseKernels kNoiseKernelsAVX2;
+	extern const NoiseKernels kNoiseKernelsAVX512;
+}
+
+#endif // GLATOR_NOISESIMD_H
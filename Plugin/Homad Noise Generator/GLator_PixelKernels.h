@@ -0,0 +1,101 @@
+/*
+	GLator_PixelKernels.h
+
+	The SIMD pixel conversions of GLator_Kernels.h, written once for any lane type
+	holding V::kPixels whole pixels, four floats each. Rows are converted
+	V::kPixels at a time and the remainder by the scalar kernels.
+
+	Before including this file, the includer declares for its lane type V, next to
+	the operations GLator_NoiseKernels.h requires:
+	- kPixels, static LoadPixels8 and LoadPixels16 (channels to float, unscaled),
+	  StorePixels8 and StorePixels16 (float to channels, truncated and saturated)
+	- ArgbToRgba, RgbaToArgb and AlphaOfRgba (alpha in all four lanes of a pixel)
+	- KeepNonZero(test, x): x in the lanes where test is not 0, 0 in the others
+
+	No include guard: every includer instantiates its own lane type.
+*/
+
+#include "GLator_Kernels.h"
+
+namespace GLatorKernels
+{
+namespace Pixels
+{
+	template <class V> inline V Clamp01(const V& x)		{ return Min(Max(x, V(0.0f)), V(1.0f)); }
+
+	// fully transparent pixels carry no colour
+	template <class V> inline V Visible(const V& rgba)	{ return KeepNonZero(AlphaOfRgba(rgba), rgba); }
+
+	template <class V>
+	void Argb8ToRgba(const void *srcP, void *dstP, A_long count)
+	{
+		const A_u_char *inP = static_cast<const A_u_char*>(srcP);
+		float *outP = static_cast<float*>(dstP);
+		A_long i = 0;
+		for (; i + V::kPixels <= count; i += V::kPixels) {
+			(ArgbToRgba(V::LoadPixels8(inP + i * 4)) * (1.0f / PF_MAX_CHAN8)).Store(outP + i * 4);
+		}
+		kPixelKernelsScalar.argb8ToRgba(inP + i * 4, outP + i * 4, count - i);
+	}
+
+	template <class V>
+	void Argb16ToRgba(const void *srcP, void *dstP, A_long count)
+	{
+		const A_u_short *inP = static_cast<const A_u_short*>(srcP);
+		float *outP = static_cast<float*>(dstP);
+		A_long i = 0;
+		for (; i + V::kPixels <= count; i += V::kPixels) {
+			(ArgbToRgba(V::LoadPixels16(inP + i * 4)) * (1.0f / PF_MAX_CHAN16)).Store(outP + i * 4);
+		}
+		kPixelKernelsScalar.argb16ToRgba(inP + i * 4, outP + i * 4, count - i);
+	}
+
+	template <class V>
+	void ArgbFloatToRgba(const void *srcP, void *dstP, A_long count)
+	{
+		const float *inP = static_cast<const float*>(srcP);
+		float *outP = static_cast<float*>(dstP);
+		A_long i = 0;
+		for (; i + V::kPixels <= count; i += V::kPixels) {
+			ArgbToRgba(V::Load(inP + i * 4)).Store(outP + i * 4);
+		}
+		kPixelKernelsScalar.argbFloatToRgba(inP + i * 4, outP + i * 4, count - i);
+	}
+
+	template <class V>
+	void RgbaToArgb8(const void *srcP, void *dstP, A_long count)
+	{
+		const float *inP = static_cast<const float*>(srcP);
+		A_u_char *outP = static_cast<A_u_char*>(dstP);
+		A_long i = 0;
+		for (; i + V::kPixels <= count; i += V::kPixels) {
+			(RgbaToArgb(Clamp01(Visible(V::Load(inP + i * 4)))) * PF_MAX_CHAN8 + 0.5f).StorePixels8(outP + i * 4);
+		}
+		kPixelKernelsScalar.rgbaToArgb8(inP + i * 4, outP + i * 4, count - i);
+	}
+
+	template <class V>
+	void RgbaToArgb16(const void *srcP, void *dstP, A_long count)
+	{
+		const float *inP = static_cast<const float*>(srcP);
+		A_u_short *outP = static_cast<A_u_short*>(dstP);
+		A_long i = 0;
+		for (; i + V::kPixels <= count; i += V::kPixels) {
+			(RgbaToArgb(Clamp01(Visible(V::Load(inP + i * 4)))) * PF_MAX_CHAN16 + 0.5f).StorePixels16(outP + i * 4);
+		}
+		kPixelKernelsScalar.rgbaToArgb16(inP + i * 4, outP + i * 4, count - i);
+	}
+
+	template <class V>
+	void RgbaToArgbFloat(const void *srcP, void *dstP, A_long count)
+	{
+		const float *inP = static_cast<const float*>(srcP);
+		float *outP = static_cast<float*>(dstP);
+		A_long i = 0;
+		for (; i + V::kPixels <= count; i += V::kPixels) {
+			RgbaToArgb(Visible(V::Load(inP + i * 4))).Store(outP + i * 4);
+		}
+		kPixelKernelsScalar.rgbaToArgbFloat(inP + i * 4, outP + i * 4, count - i);
+	}
+}
+}
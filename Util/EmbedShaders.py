@@ -0,0 +1,67 @@
+# Generates GLator_Shaders.h, the GLSL sources compiled into the plugin.
+# Run from anywhere after editing a file in GLSL_files:
+#     python Util/EmbedShaders.py
+
+import os
+
+plugin_dir = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "Plugin", "Homad Noise Generator")
+glsl_dir = os.path.join(plugin_dir, "GLSL_files")
+header_path = os.path.join(glsl_dir, "GLator_Shaders.h")
+
+shader_files = ["vertex_shader.vert",
+	"fragment_shader.frag"]
+
+# MSVC limits a single string literal to 16380 bytes, adjacent literals are concatenated
+chunk_size = 8192
+delimiter = "GLSL"
+
+
+def symbol_name(file_name):
+    return "kShader_" + file_name.replace(".", "_")
+
+
+def split_chunks(source):
+    chunks = []
+    chunk = ""
+    for line in source.splitlines(True):
+        if len(chunk) + len(line) > chunk_size:
+            chunks.append(chunk)
+            chunk = ""
+        chunk += line
+    chunks.append(chunk)
+    return chunks
+
+
+def embed_shader(file_name):
+    with open(os.path.join(glsl_dir, file_name), "r") as f:
+        source = f.read().replace("\r\n", "\n")
+
+    if ")" + delimiter + "\"" in source:
+        raise ValueError(f"{file_name} contains the raw string delimiter")
+
+    ret = f"constexpr char {symbol_name(file_name)}[] =\n"
+    for chunk in split_chunks(source):
+        ret += f"R\"{delimiter}({chunk}){delimiter}\"\n"
+    ret += ";\n"
+    return ret
+
+
+def generate_header():
+    ret = "/*\n\tGLator_Shaders.h\n\n"
+    ret += "\tGenerated by Util/EmbedShaders.py from the files in GLSL_files, do not edit.\n"
+    ret += "*/\n\n"
+    ret += "#pragma once\n\n"
+    ret += "#ifndef GLATOR_SHADERS_H\n#define GLATOR_SHADERS_H\n\n"
+    ret += "namespace AESDK_OpenGL\n{\n\n"
+    for file_name in shader_files:
+        ret += embed_shader(file_name) + "\n"
+    ret += "struct AESDK_OpenGL_EmbeddedShader\n{\n\tconst char* mNameP;\n\tconst char* mSourceP;\n};\n\n"
+    ret += "constexpr AESDK_OpenGL_EmbeddedShader kEmbeddedShaders[] = {\n"
+    ret += ",\n".join(f"\t{{ \"{file_name}\", {symbol_name(file_name)} }}" for file_name in shader_files)
+    ret += "\n};\n\n"
+    ret += "}\n\n#endif // GLATOR_SHADERS_H\n"
+    return ret
+
+
+with open(header_path, "w", newline="\n") as f:
+    f.write(generate_header())
@@ -1,390 +0,0 @@
-def generate_param(param_id, param_name):
-    ret = f"ERR(PF_CHECKOUT_PARAM(in_data,\n{param_id},\nin_data->current_time,\nin_data->time_step,\nin_data->time_scale,\n"
-    ret += "&" + param_name
-    ret += "));"
-
-    return ret
-
-def checkin_gen(param):
-    return f"ERR2(PF_CHECKIN_PARAM(in_data, &{param}));"
-
-
-def val_set(val, param):
-
-    vals = val.split("_")
-
-    if vals[3] == "START" or vals[3] == "END" or vals[2] == "START" or vals[2] == "END":
-        return "\b"
-    elif vals[3] == "CB":
-        return f"{val} = bool2float({param}.u.bd.value);"
-    elif vals[3] == "POS":
-        return f"{val} = {param}.u.fs_d.value / 10.00;"
-    else:
-        return f"{val} = {param}.u.fs_d.value / 100.00;"
-
-param_list = ["THOR_GENERIC_1D_START_Param",
-	"THOR_GENERIC_1D_VALUE_1_Param",
-	"THOR_GENERIC_1D_POS_MULT_Param",
-	"THOR_GENERIC_1D_MIX_Param",
-	"THOR_GENERIC_1D_END_Param",
-	"THOR_GENERIC_2D_START_Param",
-	"THOR_GENERIC_2D_VALUE_1_Param",
-	"THOR_GENERIC_2D_VALUE_2_Param",
-	"THOR_GENERIC_2D_POS_MULT_Param",
-	"THOR_GENERIC_2D_MIX_Param",
-	"THOR_GENERIC_2D_END_Param",
-	"THOR_GENERIC_3D_START_Param",
-	"THOR_GENERIC_3D_VALUE_1_Param",
-	"THOR_GENERIC_3D_VALUE_2_Param",
-	"THOR_GENERIC_3D_VALUE_3_Param",
-	"THOR_GENERIC_3D_POS_MULT_Param",
-	"THOR_GENERIC_3D_MIX_Param",
-	"THOR_GENERIC_3D_END_Param",
-	"THOR_PERLIN_2D_START_Param",
-	"THOR_PERLIN_2D_VALUE_1_Param",
-	"THOR_PERLIN_2D_VALUE_2_Param",
-	"THOR_PERLIN_2D_DIM_Param",
-	"THOR_PERLIN_2D_FREQ_Param",
-	"THOR_PERLIN_2D_POS_MULT_Param",
-	"THOR_PERLIN_2D_MIX_Param",
-	"THOR_PERLIN_2D_END_Param",
-	"THOR_PERLIN_3D_START_Param",
-	"THOR_PERLIN_3D_VALUE_1_Param",
-	"THOR_PERLIN_3D_VALUE_2_Param",
-	"THOR_PERLIN_3D_VALUE_3_Param",
-	"THOR_PERLIN_3D_POS_MULT_Param",
-	"THOR_PERLIN_3D_MIX_Param",
-	"THOR_PERLIN_3D_END_Param",
-	"THOR_PERLIN_4D_START_Param",
-	"THOR_PERLIN_4D_VALUE_1_Param",
-	"THOR_PERLIN_4D_VALUE_2_Param",
-	"THOR_PERLIN_4D_VALUE_3_Param",
-	"THOR_PERLIN_4D_VALUE_4_Param",
-	"THOR_PERLIN_4D_POS_MULT_Param",
-	"THOR_PERLIN_4D_MIX_Param",
-	"THOR_PERLIN_4D_END_Param",
-	"THOR_SIMPLEX_2D_START_Param",
-	"THOR_SIMPLEX_2D_VALUE_1_Param",
-	"THOR_SIMPLEX_2D_VALUE_2_Param",
-	"THOR_SIMPLEX_2D_POS_MULT_Param",
-	"THOR_SIMPLEX_2D_MIX_Param",
-	"THOR_SIMPLEX_2D_END_Param",
-	"THOR_SIMPLEX_3D_START_Param",
-	"THOR_SIMPLEX_3D_VALUE_1_Param",
-	"THOR_SIMPLEX_3D_VALUE_2_Param",
-	"THOR_SIMPLEX_3D_VALUE_3_Param",
-	"THOR_SIMPLEX_3D_POS_MULT_Param",
-	"THOR_SIMPLEX_3D_MIX_Param",
-	"THOR_SIMPLEX_3D_END_Param",
-	"THOR_SIMPLEX_4D_START_Param",
-	"THOR_SIMPLEX_4D_VALUE_1_Param",
-	"THOR_SIMPLEX_4D_VALUE_2_Param",
-	"THOR_SIMPLEX_4D_VALUE_3_Param",
-	"THOR_SIMPLEX_4D_VALUE_4_Param",
-	"THOR_SIMPLEX_4D_POS_MULT_Param",
-	"THOR_SIMPLEX_4D_MIX_Param",
-	"THOR_SIMPLEX_4D_END_Param",
-	"THOR_VIQ_2D_START_Param",
-	"THOR_VIQ_2D_VALUE_1_Param",
-	"THOR_VIQ_2D_VALUE_2_Param",
-	"THOR_VIQ_2D_U_Param",
-	"THOR_VIQ_2D_V_Param",
-	"THOR_VIQ_2D_POS_MULT_Param",
-	"THOR_VIQ_2D_MIX_Param",
-	"THOR_VIQ_2D_END_Param",
-	"THOR_VORONOI_2D_START_Param",
-	"THOR_VORONOI_2D_VALUE_1_Param",
-	"THOR_VORONOI_2D_VALUE_2_Param",
-	"THOR_VORONOI_2D_POS_MULT_Param",
-	"THOR_VORONOI_2D_MIX_Param",
-	"THOR_VORONOI_2D_END_Param",
-	"THOR_FRACTBROWN_1D_START_Param",
-	"THOR_FRACTBROWN_1D_VALUE_1_Param",
-	"THOR_FRACTBROWN_1D_POS_MULT_Param",
-	"THOR_FRACTBROWN_1D_MIX_Param",
-	"THOR_FRACTBROWN_1D_END_Param",
-	"THOR_FRACTBROWN_2D_START_Param",
-	"THOR_FRACTBROWN_2D_VALUE_1_Param",
-	"THOR_FRACTBROWN_2D_VALUE_2_Param",
-	"THOR_FRACTBROWN_2D_POS_MULT_Param",
-	"THOR_FRACTBROWN_2D_MIX_Param",
-	"THOR_FRACTBROWN_2D_END_Param",
-	"THOR_FRACTBROWN_3D_START_Param",
-	"THOR_FRACTBROWN_3D_VALUE_1_Param",
-	"THOR_FRACTBROWN_3D_VALUE_2_Param",
-	"THOR_FRACTBROWN_3D_VALUE_3_Param",
-	"THOR_FRACTBROWN_3D_POS_MULT_Param",
-	"THOR_FRACTBROWN_3D_MIX_Param",
-	"THOR_FRACTBROWN_3D_END_Param",
-	"THOR_FRACTBROWN_IQ_START_Param",
-	"THOR_FRACTBROWN_IQ_VALUE_1_Param",
-	"THOR_FRACTBROWN_IQ_VALUE_2_Param",
-	"THOR_FRACTBROWN_IQ_VALUE_3_Param",
-	"THOR_FRACTBROWN_IQ_VALUE_4_Param",
-	"THOR_FRACTBROWN_IQ_POS_MULT_Param",
-	"THOR_FRACTBROWN_IQ_MIX_Param",
-	"THOR_FRACTBROWN_IQ_END_Param",
-	"THOR_DISPLACE_START_Param",
-	"THOR_GENERIC_1D_CB_Param",
-	"THOR_GENERIC_2D_CB_Param",
-	"THOR_GENERIC_3D_CB_Param",
-	"THOR_PERLIN_2D_CB_Param",
-	"THOR_PERLIN_3D_CB_Param",
-	"THOR_PERLIN_4D_CB_Param",
-	"THOR_SIMPLEX_2D_CB_Param",
-	"THOR_SIMPLEX_3D_CB_Param",
-	"THOR_SIMPLEX_4D_CB_Param",
-	"THOR_VIQ_2D_CB_Param",
-	"THOR_VORONOI_2D_CB_Param",
-	"THOR_FACTBROWN_1D_CB_Param",
-	"THOR_FACTBROWN_2D_CB_Param",
-	"THOR_FACTBROWN_3D_CB_Param",
-	"THOR_FACTBROWN_4D_CB_Param",
-	"THOR_DISPLACE_END_Param"]
-
-
-param_list_id = [	"THOR_GENERIC_1D_START",
-	"THOR_GENERIC_1D_VALUE_1",
-	"THOR_GENERIC_1D_POS_MULT",
-	"THOR_GENERIC_1D_MIX",
-	"THOR_GENERIC_1D_END",
-	"THOR_GENERIC_2D_START",
-	"THOR_GENERIC_2D_VALUE_1",
-	"THOR_GENERIC_2D_VALUE_2",
-	"THOR_GENERIC_2D_POS_MULT",
-	"THOR_GENERIC_2D_MIX",
-	"THOR_GENERIC_2D_END",
-	"THOR_GENERIC_3D_START",
-	"THOR_GENERIC_3D_VALUE_1",
-	"THOR_GENERIC_3D_VALUE_2",
-	"THOR_GENERIC_3D_VALUE_3",
-	"THOR_GENERIC_3D_POS_MULT",
-	"THOR_GENERIC_3D_MIX",
-	"THOR_GENERIC_3D_END",
-	"THOR_PERLIN_2D_START",
-	"THOR_PERLIN_2D_VALUE_1",
-	"THOR_PERLIN_2D_VALUE_2",
-	"THOR_PERLIN_2D_DIM",
-	"THOR_PERLIN_2D_FREQ",
-	"THOR_PERLIN_2D_POS_MULT",
-	"THOR_PERLIN_2D_MIX",
-	"THOR_PERLIN_2D_END",
-	"THOR_PERLIN_3D_START",
-	"THOR_PERLIN_3D_VALUE_1",
-	"THOR_PERLIN_3D_VALUE_2",
-	"THOR_PERLIN_3D_VALUE_3",
-	"THOR_PERLIN_3D_POS_MULT",
-	"THOR_PERLIN_3D_MIX",
-	"THOR_PERLIN_3D_END",
-	"THOR_PERLIN_4D_START",
-	"THOR_PERLIN_4D_VALUE_1",
-	"THOR_PERLIN_4D_VALUE_2",
-	"THOR_PERLIN_4D_VALUE_3",
-	"THOR_PERLIN_4D_VALUE_4",
-	"THOR_PERLIN_4D_POS_MULT",
-	"THOR_PERLIN_4D_MIX",
-	"THOR_PERLIN_4D_END",
-	"THOR_SIMPLEX_2D_START",
-	"THOR_SIMPLEX_2D_VALUE_1",
-	"THOR_SIMPLEX_2D_VALUE_2",
-	"THOR_SIMPLEX_2D_POS_MULT",
-	"THOR_SIMPLEX_2D_MIX",
-	"THOR_SIMPLEX_2D_END",
-	"THOR_SIMPLEX_3D_START",
-	"THOR_SIMPLEX_3D_VALUE_1",
-	"THOR_SIMPLEX_3D_VALUE_2",
-	"THOR_SIMPLEX_3D_VALUE_3",
-	"THOR_SIMPLEX_3D_POS_MULT",
-	"THOR_SIMPLEX_3D_MIX",
-	"THOR_SIMPLEX_3D_END",
-	"THOR_SIMPLEX_4D_START",
-	"THOR_SIMPLEX_4D_VALUE_1",
-	"THOR_SIMPLEX_4D_VALUE_2",
-	"THOR_SIMPLEX_4D_VALUE_3",
-	"THOR_SIMPLEX_4D_VALUE_4",
-	"THOR_SIMPLEX_4D_POS_MULT",
-	"THOR_SIMPLEX_4D_MIX",
-	"THOR_SIMPLEX_4D_END",
-	"THOR_VIQ_2D_START",
-	"THOR_VIQ_2D_VALUE_1",
-	"THOR_VIQ_2D_VALUE_2",
-	"THOR_VIQ_2D_U",
-	"THOR_VIQ_2D_V",
-	"THOR_VIQ_2D_POS_MULT",
-	"THOR_VIQ_2D_MIX",
-	"THOR_VIQ_2D_END",
-	"THOR_VORONOI_2D_START",
-	"THOR_VORONOI_2D_VALUE_1",
-	"THOR_VORONOI_2D_VALUE_2",
-	"THOR_VORONOI_2D_POS_MULT",
-	"THOR_VORONOI_2D_MIX",
-	"THOR_VORONOI_2D_END",
-	"THOR_FRACTBROWN_1D_START",
-	"THOR_FRACTBROWN_1D_VALUE_1",
-	"THOR_FRACTBROWN_1D_POS_MULT",
-	"THOR_FRACTBROWN_1D_MIX",
-	"THOR_FRACTBROWN_1D_END",
-	"THOR_FRACTBROWN_2D_START",
-	"THOR_FRACTBROWN_2D_VALUE_1",
-	"THOR_FRACTBROWN_2D_VALUE_2",
-	"THOR_FRACTBROWN_2D_POS_MULT",
-	"THOR_FRACTBROWN_2D_MIX",
-	"THOR_FRACTBROWN_2D_END",
-	"THOR_FRACTBROWN_3D_START",
-	"THOR_FRACTBROWN_3D_VALUE_1",
-	"THOR_FRACTBROWN_3D_VALUE_2",
-	"THOR_FRACTBROWN_3D_VALUE_3",
-	"THOR_FRACTBROWN_3D_POS_MULT",
-	"THOR_FRACTBROWN_3D_MIX",
-	"THOR_FRACTBROWN_3D_END",
-	"THOR_FRACTBROWN_IQ_START",
-	"THOR_FRACTBROWN_IQ_VALUE_1",
-	"THOR_FRACTBROWN_IQ_VALUE_2",
-	"THOR_FRACTBROWN_IQ_VALUE_3",
-	"THOR_FRACTBROWN_IQ_VALUE_4",
-	"THOR_FRACTBROWN_IQ_POS_MULT",
-	"THOR_FRACTBROWN_IQ_MIX",
-	"THOR_FRACTBROWN_IQ_END",
-	"THOR_DISPLACE_START",
-	"THOR_GENERIC_1D_CB",
-	"THOR_GENERIC_2D_CB",
-	"THOR_GENERIC_3D_CB",
-	"THOR_PERLIN_2D_CB",
-	"THOR_PERLIN_3D_CB",
-	"THOR_PERLIN_4D_CB",
-	"THOR_SIMPLEX_2D_CB",
-	"THOR_SIMPLEX_3D_CB",
-	"THOR_SIMPLEX_4D_CB",
-	"THOR_VIQ_2D_CB",
-	"THOR_VORONOI_2D_CB",
-	"THOR_FACTBROWN_1D_CB",
-	"THOR_FACTBROWN_2D_CB",
-	"THOR_FACTBROWN_3D_CB",
-	"THOR_FACTBROWN_4D_CB",
-	"THOR_DISPLACE_END"]
-
-
-vals = ["THOR_GENERIC_1D_START_Val",
-	"THOR_GENERIC_1D_VALUE_1_Val",
-	"THOR_GENERIC_1D_POS_MULT_Val",
-	"THOR_GENERIC_1D_MIX_Val",
-	"THOR_GENERIC_1D_END_Val",
-	"THOR_GENERIC_2D_START_Val",
-	"THOR_GENERIC_2D_VALUE_1_Val",
-	"THOR_GENERIC_2D_VALUE_2_Val",
-	"THOR_GENERIC_2D_POS_MULT_Val",
-	"THOR_GENERIC_2D_MIX_Val",
-	"THOR_GENERIC_2D_END_Val",
-	"THOR_GENERIC_3D_START_Val",
-	"THOR_GENERIC_3D_VALUE_1_Val",
-	"THOR_GENERIC_3D_VALUE_2_Val",
-	"THOR_GENERIC_3D_VALUE_3_Val",
-	"THOR_GENERIC_3D_POS_MULT_Val",
-	"THOR_GENERIC_3D_MIX_Val",
-	"THOR_GENERIC_3D_END_Val",
-	"THOR_PERLIN_2D_START_Val",
-	"THOR_PERLIN_2D_VALUE_1_Val",
-	"THOR_PERLIN_2D_VALUE_2_Val",
-	"THOR_PERLIN_2D_DIM_Val",
-	"THOR_PERLIN_2D_FREQ_Val",
-	"THOR_PERLIN_2D_POS_MULT_Val",
-	"THOR_PERLIN_2D_MIX_Val",
-	"THOR_PERLIN_2D_END_Val",
-	"THOR_PERLIN_3D_START_Val",
-	"THOR_PERLIN_3D_VALUE_1_Val",
-	"THOR_PERLIN_3D_VALUE_2_Val",
-	"THOR_PERLIN_3D_VALUE_3_Val",
-	"THOR_PERLIN_3D_POS_MULT_Val",
-	"THOR_PERLIN_3D_MIX_Val",
-	"THOR_PERLIN_3D_END_Val",
-	"THOR_PERLIN_4D_START_Val",
-	"THOR_PERLIN_4D_VALUE_1_Val",
-	"THOR_PERLIN_4D_VALUE_2_Val",
-	"THOR_PERLIN_4D_VALUE_3_Val",
-	"THOR_PERLIN_4D_VALUE_4_Val",
-	"THOR_PERLIN_4D_POS_MULT_Val",
-	"THOR_PERLIN_4D_MIX_Val",
-	"THOR_PERLIN_4D_END_Val",
-	"THOR_SIMPLEX_2D_START_Val",
-	"THOR_SIMPLEX_2D_VALUE_1_Val",
-	"THOR_SIMPLEX_2D_VALUE_2_Val",
-	"THOR_SIMPLEX_2D_POS_MULT_Val",
-	"THOR_SIMPLEX_2D_MIX_Val",
-	"THOR_SIMPLEX_2D_END_Val",
-	"THOR_SIMPLEX_3D_START_Val",
-	"THOR_SIMPLEX_3D_VALUE_1_Val",
-	"THOR_SIMPLEX_3D_VALUE_2_Val",
-	"THOR_SIMPLEX_3D_VALUE_3_Val",
-	"THOR_SIMPLEX_3D_POS_MULT_Val",
-	"THOR_SIMPLEX_3D_MIX_Val",
-	"THOR_SIMPLEX_3D_END_Val",
-	"THOR_SIMPLEX_4D_START_Val",
-	"THOR_SIMPLEX_4D_VALUE_1_Val",
-	"THOR_SIMPLEX_4D_VALUE_2_Val",
-	"THOR_SIMPLEX_4D_VALUE_3_Val",
-	"THOR_SIMPLEX_4D_VALUE_4_Val",
-	"THOR_SIMPLEX_4D_POS_MULT_Val",
-	"THOR_SIMPLEX_4D_MIX_Val",
-	"THOR_SIMPLEX_4D_END_Val",
-	"THOR_VIQ_2D_START_Val",
-	"THOR_VIQ_2D_VALUE_1_Val",
-	"THOR_VIQ_2D_VALUE_2_Val",
-	"THOR_VIQ_2D_U_Val",
-	"THOR_VIQ_2D_V_Val",
-	"THOR_VIQ_2D_POS_MULT_Val",
-	"THOR_VIQ_2D_MIX_Val",
-	"THOR_VIQ_2D_END_Val",
-	"THOR_VORONOI_2D_START_Val",
-	"THOR_VORONOI_2D_VALUE_1_Val",
-	"THOR_VORONOI_2D_VALUE_2_Val",
-	"THOR_VORONOI_2D_POS_MULT_Val",
-	"THOR_VORONOI_2D_MIX_Val",
-	"THOR_VORONOI_2D_END_Val",
-	"THOR_FRACTBROWN_1D_START_Val",
-	"THOR_FRACTBROWN_1D_VALUE_1_Val",
-	"THOR_FRACTBROWN_1D_POS_MULT_Val",
-	"THOR_FRACTBROWN_1D_MIX_Val",
-	"THOR_FRACTBROWN_1D_END_Val",
-	"THOR_FRACTBROWN_2D_START_Val",
-	"THOR_FRACTBROWN_2D_VALUE_1_Val",
-	"THOR_FRACTBROWN_2D_VALUE_2_Val",
-	"THOR_FRACTBROWN_2D_POS_MULT_Val",
-	"THOR_FRACTBROWN_2D_MIX_Val",
-	"THOR_FRACTBROWN_2D_END_Val",
-	"THOR_FRACTBROWN_3D_START_Val",
-	"THOR_FRACTBROWN_3D_VALUE_1_Val",
-	"THOR_FRACTBROWN_3D_VALUE_2_Val",
-	"THOR_FRACTBROWN_3D_VALUE_3_Val",
-	"THOR_FRACTBROWN_3D_POS_MULT_Val",
-	"THOR_FRACTBROWN_3D_MIX_Val",
-	"THOR_FRACTBROWN_3D_END_Val",
-	"THOR_FRACTBROWN_IQ_START_Val",
-	"THOR_FRACTBROWN_IQ_VALUE_1_Val",
-	"THOR_FRACTBROWN_IQ_VALUE_2_Val",
-	"THOR_FRACTBROWN_IQ_VALUE_3_Val",
-	"THOR_FRACTBROWN_IQ_VALUE_4_Val",
-	"THOR_FRACTBROWN_IQ_POS_MULT_Val",
-	"THOR_FRACTBROWN_IQ_MIX_Val",
-	"THOR_FRACTBROWN_IQ_END_Val",
-	"THOR_DISPLACE_START_Val",
-	"THOR_GENERIC_1D_CB_Val",
-	"THOR_GENERIC_2D_CB_Val",
-	"THOR_GENERIC_3D_CB_Val",
-	"THOR_PERLIN_2D_CB_Val",
-	"THOR_PERLIN_3D_CB_Val",
-	"THOR_PERLIN_4D_CB_Val",
-	"THOR_SIMPLEX_2D_CB_Val",
-	"THOR_SIMPLEX_3D_CB_Val",
-	"THOR_SIMPLEX_4D_CB_Val",
-	"THOR_VIQ_2D_CB_Val",
-	"THOR_VORONOI_2D_CB_Val",
-	"THOR_FACTBROWN_1D_CB_Val",
-	"THOR_FACTBROWN_2D_CB_Val",
-	"THOR_FACTBROWN_3D_CB_Val",
-	"THOR_FACTBROWN_4D_CB_Val",
-	"THOR_DISPLACE_END_Val"]
-
-
-for i in range(0, len(param_list)):
-    print(val_set(vals[i], param_list[i]))
-